@@ -0,0 +1,98 @@
+#include "Deck.h"
+#include "FiveHand.h"
+#include "Random.h"
+#include "ShuffleBatch.h"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+// Keeps the shuffle-only loops from being optimized away
+static volatile unsigned long long sink;
+
+
+/* Returns the seconds elapsed since a starting time.
+   param: start - time_point representing the start.
+   return: double representing the elapsed seconds. */
+static double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+
+/* Prints one line of the benchmark results.
+   param: name - string representing what was measured.
+   param: games - long representing the number of games.
+   param: seconds - double representing the time taken. */
+static void printRate(std::string name, long games, double seconds) {
+    std::cout << "  " << name << long(games / seconds) << " games/s (" << seconds << " s)" << std::endl;
+}
+
+
+/* Main method for the Monte Carlo simulation benchmark.
+   Plays the same seeded games through the one-game-at-a-time path (FiveHand, Deck and Hand)
+   and through the batched path (ShuffleBatch), checks that both found the same strength key
+   for every hand, and prints the rate of each.
+   Usage: benchmark [games] [seed] [lanes]
+   param: agrc - int representing the number of command line arguments.
+   param: argv - string array representing command line arguments. */
+int main(int argc, char *argv[]) {
+    long games = (argc > 1) ? std::atol(argv[1]) : 1000000;
+    unsigned long long base = (argc > 2) ? std::strtoull(argv[2], NULL, 10) : 1;
+    int lanes = (argc > 3) ? std::atoi(argv[3]) : 256;
+
+    if (games < 1 || lanes < 1) {
+        std::cerr << "usage: benchmark [games] [seed] [lanes], games and lanes being at least 1" << std::endl;
+        return 2;
+    }
+
+    std::cout << "\n*** Simulating " << games << " games, " << lanes << " decks per batch ***" << std::endl;
+
+    // Shuffling only
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (long i = 0; i < games; i++) {
+        Deck deck;
+        deck.buildSeededDeck(Random::gameSeed(base, i));
+        sink += deck.drawCard().getCode();
+    }
+    printRate("Shuffle, one deck at a time: ", games, secondsSince(start));
+
+    ShuffleBatch batch(lanes);
+    std::vector<unsigned long long> seeds(lanes);
+
+    start = std::chrono::steady_clock::now();
+    for (long i = 0; i < games; i += lanes) {
+        for (int l = 0; l < lanes; l++) seeds[l] = Random::gameSeed(base, i + l);
+        batch.shuffle(seeds.data());
+        sink += batch.getCard(0, 0);
+    }
+    printRate("Shuffle, batched:            ", games, secondsSince(start));
+
+    // Full games: shuffle, deal and evaluate
+    unsigned long long single = 0;
+    start = std::chrono::steady_clock::now();
+    for (long i = 0; i < games; i++) {
+        FiveHand game(Random::gameSeed(base, i));
+        game.drawCards(0);
+
+        for (Hand &hand: game.getHands()) single = single * 31 + hand.getStrengthKey();
+    }
+    printRate("Game, one at a time:         ", games, secondsSince(start));
+
+    unsigned long long batched = 0;
+    std::vector<int> keys(lanes * 6);
+    start = std::chrono::steady_clock::now();
+    for (long i = 0; i < games; i += lanes) {
+        for (int l = 0; l < lanes; l++) seeds[l] = Random::gameSeed(base, i + l);
+        batch.shuffle(seeds.data());
+        batch.dealKeys(keys.data());
+
+        int n = (games - i < lanes) ? games - i : lanes;
+        for (int k = 0; k < n * 6; k++) batched = batched * 31 + keys[k];
+    }
+    printRate("Game, batched:               ", games, secondsSince(start));
+
+    bool same = single == batched;
+    std::cout << "  Results match: " << (same ? "yes" : "NO") << std::endl;
+
+    return same ? 0 : 1;
+}
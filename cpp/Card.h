@@ -35,6 +35,11 @@ public:
     int getSuit() {return suit;}
 
 
+    /* Gets the code of the card, a number from 0 to 51 equal to suit * 13 + (rank - 2).
+       return: int - representing the code of the card. */
+    int getCode() {return suit * 13 + rank - 2;}
+
+
     // Outer-Defined Class Methods //
     std::string toString();
     int compareCard(Card& other);
@@ -0,0 +1,338 @@
+#include "Client.h"
+#include "Evaluator.h"
+#include "FiveHand.h"
+#include "Random.h"
+#include "Server.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <thread>
+#include <vector>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+// Closes the connection, if any.
+Client::~Client() {
+    if (fd >= 0) close(fd);
+}
+
+
+/* Connects to a server's Unix domain socket.
+   param: path - string representing the path of the socket.
+   return: bool representing if the connection was made. */
+bool Client::connectTo(std::string &path) {
+    sockaddr_un addr;
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    std::strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+
+    fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    return fd >= 0 && connect(fd, (sockaddr*) &addr, sizeof(addr)) == 0;
+}
+
+
+/* Sends one request and waits for its response.
+   param: op - int representing the operation.
+   param: id - unsigned int representing the request's id.
+   param: body - string representing the request body.
+   param: response - string set to the response body.
+   return: int representing the response status, or -1 if the connection failed. */
+int Client::request(int op, unsigned int id, std::string &body, std::string &response) {
+    unsigned int responseId;
+    if (!send(op, id, body)) return -1;
+
+    int status = receive(responseId, response);
+    return (responseId == id) ? status : -1;
+}
+
+
+/* Sends one request without waiting for its response.
+   param: op - int representing the operation.
+   param: id - unsigned int representing the request's id.
+   param: body - string representing the request body.
+   return: bool representing if the request was sent. */
+bool Client::send(int op, unsigned int id, std::string &body) {
+    std::string frame = Server::frame(op, Server::OK, id, body);
+    return write(fd, frame.data(), frame.size()) == (ssize_t) frame.size();
+}
+
+
+/* Shuts down the sending side of the connection, telling the server no more requests follow.
+   Responses to the requests already sent can still be received.
+   return: bool representing if the connection was shut down. */
+bool Client::finish() {
+    return shutdown(fd, SHUT_WR) == 0;
+}
+
+
+/* Waits for the next response, which may answer any request sent on this connection.
+   param: id - unsigned int set to the id of the request answered.
+   param: response - string set to the response body.
+   return: int representing the response status, or -1 if the connection failed or was closed. */
+int Client::receive(unsigned int &id, std::string &response) {
+    char header[Server::HEADER_SIZE];
+    if (!readFully(header, Server::HEADER_SIZE)) return -1;
+
+    unsigned int length;
+    std::memcpy(&length, header, 4);
+    std::memcpy(&id, header + 8, 4);
+
+    response.resize(length + 4 - Server::HEADER_SIZE);
+    if (!readFully(&response[0], response.size())) return -1;
+
+    return header[5];
+}
+
+
+/* Reads exactly the requested number of bytes from the socket.
+   param: buffer - char array to read into.
+   param: size - size_t representing the number of bytes to read.
+   return: bool representing if all bytes were read. */
+bool Client::readFully(char* buffer, size_t size) {
+    while (size > 0) {
+        ssize_t n = read(fd, buffer, size);
+        if (n <= 0) return false;
+
+        buffer += n;
+        size -= n;
+    }
+
+    return true;
+}
+
+
+/* Builds a request body and the response a correct server must give, for request number i.
+   Cards come from a seeded game, so every request is different but reproducible.
+   param: op - int representing the operation.
+   param: i - long representing the request number.
+   param: batch - int representing the number of hands for EVALUATE.
+   param: body - string set to the request body.
+   param: expected - string set to the expected response body. */
+static void buildRequest(int op, long i, int batch, std::string &body, std::string &expected) {
+    unsigned long long seed = Random::gameSeed(1, i);
+    FiveHand game(seed);
+    game.drawCards(0);
+
+    body.clear();
+    expected.clear();
+
+    if (op == Server::DEAL) {
+        body.append((const char*) &seed, 8);
+
+        for (Hand &hand: game.getHands()) {
+            for (Card &card: hand.getCards()) expected += (char) card.getCode();
+        }
+        for (int h: game.winningOrder()) expected += (char) h;
+        for (Hand &hand: game.getHands()) {
+            int key = hand.getStrengthKey();
+            expected.append((const char*) &key, 4);
+        }
+    } else if (op == Server::RANK) {
+        body += (char) 6;
+
+        for (Hand &hand: game.getHands()) {
+            for (Card &card: hand.getCards()) body += (char) card.getCode();
+        }
+        for (int h: game.winningOrder()) expected += (char) h;
+    } else {
+        unsigned short n = batch;
+        body.append((const char*) &n, 2);
+
+        for (int h = 0; h < batch; h++) {
+            Hand &hand = game.getHands()[h % 6];
+            int codes[5];
+
+            // Rotate the cards so repeated hands are still new requests
+            for (int c = 0; c < 5; c++) {
+                codes[c] = (hand.getCards()[c].getCode() + h / 6) % 52;
+                body += (char) codes[c];
+            }
+
+            int key = Evaluator::codeStrengthKey(codes);
+            expected.append((const char*) &key, 4);
+        }
+    }
+}
+
+
+/* Sends a request whose hand holds the same card five times, which the server must refuse.
+   param: client - Client representing the connected client.
+   param: op - int representing the operation, RANK or EVALUATE.
+   return: long representing 1 if the request was not answered with BAD_REQUEST, 0 if it was. */
+static long sendRepeatedCard(Client &client, int op) {
+    std::string body, response;
+    unsigned short n = 1;
+
+    if (op == Server::RANK) body += (char) n;
+    else body.append((const char*) &n, 2);
+    body.append(5, (char) 13);
+
+    return client.request(op, 0, body, response) == Server::BAD_REQUEST ? 0 : 1;
+}
+
+
+/* Sends a connection's requests one at a time, each waiting for its response.
+   param: client - Client representing the connected client.
+   param: op - int representing the operation.
+   param: first - long representing the connection's first request number.
+   param: step - long representing the distance between its request numbers.
+   param: requests - long representing the total number of requests.
+   param: batch - int representing the number of hands for EVALUATE.
+   param: times - vector set to the round trip time of every request, in microseconds.
+   return: long representing the number of failed requests. */
+static long sendInTurn(Client &client, int op, long first, long step, long requests, int batch,
+                       std::vector<long long> &times) {
+    std::string body, expected, response;
+    long failed = 0;
+
+    for (long i = first; i < requests; i += step) {
+        buildRequest(op, i, batch, body, expected);
+
+        std::chrono::steady_clock::time_point sent = std::chrono::steady_clock::now();
+        int status = client.request(op, i, body, response);
+        std::chrono::steady_clock::duration rtt = std::chrono::steady_clock::now() - sent;
+
+        times.push_back(std::chrono::duration_cast<std::chrono::microseconds>(rtt).count());
+        if (status != Server::OK || response != expected) failed++;
+    }
+
+    return failed;
+}
+
+
+/* Sends all of a connection's requests at once, shuts down its sending side, then reads the
+   responses, in any order, until the server closes the connection.
+   param: client - Client representing the connected client.
+   param: op - int representing the operation.
+   param: first - long representing the connection's first request number.
+   param: step - long representing the distance between its request numbers.
+   param: requests - long representing the total number of requests.
+   param: batch - int representing the number of hands for EVALUATE.
+   param: times - vector set to the time from sending to answer of every request, in microseconds.
+   return: long representing the number of failed or unanswered requests. */
+static long sendPipelined(Client &client, int op, long first, long step, long requests, int batch,
+                          std::vector<long long> &times) {
+    std::vector<std::string> expected;
+    std::vector<std::chrono::steady_clock::time_point> sent;
+    std::vector<bool> answered;
+    std::string body, response;
+    long failed = 0;
+
+    for (long i = first; i < requests; i += step) {
+        expected.push_back("");
+        buildRequest(op, i, batch, body, expected.back());
+
+        sent.push_back(std::chrono::steady_clock::now());
+        answered.push_back(false);
+        if (!client.send(op, i, body)) return expected.size();
+    }
+
+    if (!client.finish()) return expected.size();
+
+    unsigned int id;
+    int status;
+
+    while ((status = client.receive(id, response)) >= 0) {
+        long offset = long(id) - first;
+        size_t k = offset / step;
+
+        if (offset < 0 || offset % step != 0 || k >= expected.size() || answered[k]) {
+            failed++;
+            continue;
+        }
+
+        std::chrono::steady_clock::duration elapsed = std::chrono::steady_clock::now() - sent[k];
+        times.push_back(std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count());
+        answered[k] = true;
+        if (status != Server::OK || response != expected[k]) failed++;
+    }
+
+    return failed + std::count(answered.begin(), answered.end(), false);
+}
+
+
+/* Main method for the server test client.
+   Sends requests from several connections, checks every response and prints round trip latency.
+   With "pipeline", each connection sends all its requests before shutting down its sending side,
+   and every request must still be answered before the server closes the connection.
+   Usage: client <socket path> <requests> [deal|rank|evaluate] [batch] [connections] [pipeline]
+   param: agrc - int representing the number of command line arguments.
+   param: argv - string array representing command line arguments. */
+int main(int argc, char *argv[]) {
+    if (argc < 3) {
+        std::cerr << "usage: client <socket path> <requests> [deal|rank|evaluate] [batch] [connections] [pipeline]"
+                  << std::endl;
+        return 2;
+    }
+
+    std::string path = argv[1];
+    long requests = std::atol(argv[2]);
+    std::string name = (argc > 3) ? argv[3] : "deal";
+    int batch = (argc > 4) ? std::atoi(argv[4]) : 64;
+    int connections = (argc > 5) ? std::atoi(argv[5]) : 1;
+    bool pipeline = (argc > 6) && std::string(argv[6]) == "pipeline";
+    int op = (name == "rank") ? Server::RANK : (name == "evaluate") ? Server::EVALUATE : Server::DEAL;
+
+    std::vector<std::vector<long long>> times(connections);
+    std::atomic<long> failures(0);
+    std::vector<std::thread> threads;
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    for (int c = 0; c < connections; c++) {
+        threads.push_back(std::thread([&, c]() {
+            Client client;
+            if (!client.connectTo(path)) {
+                failures++;
+                return;
+            }
+
+            if (pipeline) failures += sendPipelined(client, op, c, connections, requests, batch, times[c]);
+            else failures += sendInTurn(client, op, c, connections, requests, batch, times[c]);
+        }));
+    }
+
+    for (std::thread &thread: threads) thread.join();
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::vector<long long> all;
+    for (std::vector<long long> &t: times) all.insert(all.end(), t.begin(), t.end());
+    std::sort(all.begin(), all.end());
+
+    if (all.empty()) {
+        std::cerr << "No requests completed" << std::endl;
+        return 1;
+    }
+
+    // A hand holding a card twice must be refused, not evaluated
+    Client probe;
+    if (op != Server::DEAL && (!probe.connectTo(path) || sendRepeatedCard(probe, op) != 0)) {
+        std::cerr << "A " << name << " request repeating a card was not refused" << std::endl;
+        failures++;
+    }
+
+    std::cout << "\n*** " << all.size() << " " << name << " requests, " << failures << " failed ***\n"
+              << "  Throughput:      " << long(all.size() / seconds) << " requests/s\n"
+              << "  Round trip p50:  " << all[all.size() / 2] << " us\n"
+              << "  Round trip p99:  " << all[all.size() * 99 / 100] << " us" << std::endl;
+
+    Client client;
+    std::string body, response;
+    if (client.connectTo(path) && client.request(Server::STATS, 0, body, response) == Server::OK) {
+        long long count;
+        int p50, p99;
+        std::memcpy(&count, response.data(), 8);
+        std::memcpy(&p50, response.data() + 8, 4);
+        std::memcpy(&p99, response.data() + 12, 4);
+
+        std::cout << "  Server p50:      " << p50 << " us\n"
+                  << "  Server p99:      " << p99 << " us (" << count << " requests served)" << std::endl;
+    }
+
+    return failures == 0 ? 0 : 1;
+}
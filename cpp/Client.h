@@ -0,0 +1,34 @@
+#ifndef CLIENT
+#define CLIENT
+
+#include <string>
+
+/* Represents a blocking client of the Five Hand server (see Server.h for the protocol).
+   Used to test the server and to measure its round trip latency. */
+class Client {
+
+private:
+
+    int fd;
+
+    // Outer-Defined Class Methods //
+    bool readFully(char* buffer, size_t size);
+
+public:
+
+    /* Constructs a new client that is not connected yet. */
+    Client() : fd(-1) {}
+
+
+    // Outer-Defined Class Methods //
+    ~Client();
+    bool connectTo(std::string& path);
+    int request(int op, unsigned int id, std::string& body, std::string& response);
+    bool send(int op, unsigned int id, std::string& body);
+    bool finish();
+    int receive(unsigned int& id, std::string& response);
+
+};
+
+
+#endif
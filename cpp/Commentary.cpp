@@ -0,0 +1,80 @@
+#include "Evaluator.h"
+#include "FiveHand.h"
+#include "Outs.h"
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+
+static const char* TYPE_NAMES[] = {"", "High Card", "Pair", "Two Pair", "Three of a Kind", "Straight",
+                                   "Flush", "Full House", "Four of a Kind", "Straight Flush",
+                                   "Royal Straight Flush"};
+
+
+/* Checks every completion of an analysis against Evaluator on the full five cards.
+   param: hand - Hand representing the partial hand.
+   param: outs - Outs representing the analysis of the hand.
+   return: long representing the number of completions that did not match. */
+static long verify(Hand &hand, Outs &outs) {
+    long failed = 0;
+    int dealt = hand.getCards().size();
+
+    for (long i = 0; i < outs.getCompletions(); i++) {
+        int codes[5];
+        for (int c = 0; c < dealt; c++) codes[c] = hand.getCards()[c].getCode();
+        for (int c = dealt; c < 5; c++) codes[c] = outs.getAddedCard(i, c - dealt);
+
+        if (Evaluator::codeStrengthKey(codes) != outs.getKey(i)) failed++;
+    }
+
+    return failed;
+}
+
+
+/* Main method for the live commentary demo.
+   Deals a seeded game one round at a time and, after each of the first four rounds, prints
+   every seat's chances of finishing with each hand type and how long the analysis took.
+   Usage: commentary [seed] [-verify]
+   param: agrc - int representing the number of command line arguments.
+   param: argv - string array representing command line arguments. */
+int main(int argc, char *argv[]) {
+    unsigned long long seed = (argc > 1) ? std::strtoull(argv[1], NULL, 10) : 1;
+    bool check = argc > 2 && std::string(argv[2]) == "-verify";
+    long failed = 0;
+
+    FiveHand game(seed);
+    std::cout << std::fixed;
+
+    // Build the shared tables and the largest buffers (one card dealt to each seat) up front so
+    // the first seat's time is comparable to the others; the one analysis is reused for every seat
+    Outs::prepare();
+    Outs outs;
+    outs.reserve(4, 46);
+
+    for (int round = 1; round <= 4; round++) {
+        game.drawRound();
+        std::cout << "\n*** After round " << round << " ***" << std::endl;
+
+        int seat = 1;
+        for (Hand &hand: game.getHands()) {
+            std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            outs.analyze(hand, game.getDeck());
+            double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+            std::cout << "Seat " << seat++ << ": " << hand.toString() << "(" << outs.getCompletions()
+                      << " completions, " << std::setprecision(3) << ms << " ms)\n    ";
+
+            for (int type = 10; type >= 1; type--) {
+                double p = outs.getProbability(type);
+                if (p > 0) std::cout << TYPE_NAMES[type] << " " << std::setprecision(2) << 100 * p << "%  ";
+            }
+            std::cout << std::endl;
+
+            if (check) failed += verify(hand, outs);
+        }
+    }
+
+    if (check) std::cout << "\n*** " << failed << " completions did not match Evaluator ***" << std::endl;
+
+    return failed == 0 ? 0 : 1;
+}
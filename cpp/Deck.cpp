@@ -1,4 +1,5 @@
 #include "Deck.h"
+#include "Random.h"
 #include <fstream>
 #include <iostream>
 #include <sstream>
@@ -34,7 +35,29 @@ void Deck::buildRandDeck() {
         }
     }
 
-    cards = shuffleDeck(cards);
+    shuffleDeck(cards);
+}
+
+
+/* Builds a random deck whose order is fully determined by a seed.
+   The same seed always produces the same deck, so a seeded game can be replayed.
+   param: seed - unsigned long long representing the seed of the shuffle. */
+void Deck::buildSeededDeck(unsigned long long seed) {
+    deckType = 0;
+
+    for (int suit = 0; suit <= 3; suit++) {
+        for (int rank = 2; rank <= 14; rank++) {
+            cards.push_back(Card(rank, suit));
+        }
+    }
+
+    Random rng(seed);
+    for (int n = cards.size() - 1; n > 0; n--) {
+        int k = rng.bounded(n + 1);
+        Card value = cards[k];
+        cards[k] = cards[n];
+        cards[n] = value;
+    }
 }
 
 
@@ -42,18 +65,27 @@ void Deck::buildRandDeck() {
    Stops code if an invalid file name is provided
    param: file - string representing the file to build the deck from. */
 void Deck::buildFileDeck(std::string &file) {
-    deckType = 1;
-
     std::ifstream inputFile(file);
 
     if (!inputFile.is_open()) {
+        deckType = 1;
         std::cerr << "Failed to open file: " << file << std::endl;
         return;
     }
 
+    buildStreamDeck(inputFile);
+    inputFile.close();
+}
+
+
+/* Builds a deck from text in the test deck format, one hand per line.
+   param: in - istream representing the text to build the deck from. */
+void Deck::buildStreamDeck(std::istream &in) {
+    deckType = 1;
+
     std::string line;
-    while (inputFile) {
-        std::getline(inputFile, line);
+    while (in) {
+        std::getline(in, line);
         std::vector<std::string> lineList = lineSplit(line, ',');
 
         for (std::string s : lineList) {
@@ -82,8 +114,6 @@ void Deck::buildFileDeck(std::string &file) {
             cards.push_back(Card(rank, suit));
         }
     }
-
-    inputFile.close();
 }
 
 
@@ -96,10 +126,9 @@ Card Deck::drawCard() {
 }
 
 
-/* Returns a shuffled version of a provided deck.
-   param: deck - vector representing the deck to be shuffled.
-   return: vector representing the shuffled deck. */
-std::vector<Card> Deck::shuffleDeck(std::vector<Card> deck) {
+/* Shuffles a provided deck in place.
+   param: deck - vector representing the deck to be shuffled. */
+void Deck::shuffleDeck(std::vector<Card> &deck) {
     srand(static_cast<unsigned int>(time(nullptr)));
     int n = deck.size();
 
@@ -110,8 +139,6 @@ std::vector<Card> Deck::shuffleDeck(std::vector<Card> deck) {
         deck[k] = deck[n];
         deck[n] = value;
     }
-
-    return deck;
 }
 
 
@@ -1,6 +1,7 @@
 #ifndef DECK
 #define DECK
 
+#include <istream>
 #include <string>
 #include <vector>
 #include "Card.h"
@@ -18,7 +19,7 @@ private:
     int deckType;
 
     // Outer-Defined Class Methods //
-    std::vector <Card> shuffleDeck(std::vector<Card> deck);
+    void shuffleDeck(std::vector<Card>& deck);
 
 public:
 
@@ -31,10 +32,17 @@ public:
     Card* getDuplicate() {return duplicate;}
 
 
+    /* Gets the cards left in the deck, the next card to be drawn first.
+       return: vector representing the remaining cards. */
+    std::vector<Card>& getCards() {return cards;}
+
+
     // Outer-Defined Class Methods //
     std::string toString();
     void buildRandDeck();
+    void buildSeededDeck(unsigned long long seed);
     void buildFileDeck(std::string& file);
+    void buildStreamDeck(std::istream& in);
     Card drawCard();
     std::vector<std::string> lineSplit(std::string s, char del);
     
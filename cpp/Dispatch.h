@@ -0,0 +1,17 @@
+#ifndef DISPATCH
+#define DISPATCH
+
+/* Marks a hot loop to be compiled once per instruction set, the best version for the running CPU
+   being picked when the program starts (GCC function multi-versioning).
+   Enabled by the FIVEHAND_DISPATCH build option (on by default in CMakeLists.txt, -DFIVEHAND_DISPATCH
+   when compiling by hand); otherwise the loop is compiled once, for the target chosen by the
+   compiler flags (see FIVEHAND_MARCH). The hot loops need 64 bit vector compares and multiplies,
+   so a baseline x86-64 build without dispatch does not vectorize them. */
+#if defined(FIVEHAND_DISPATCH) && defined(__GNUC__) && !defined(__clang__) && defined(__x86_64__)
+#define HOT_CLONES __attribute__((target_clones("avx512f", "avx2", "default")))
+#else
+#define HOT_CLONES
+#endif
+
+
+#endif
@@ -0,0 +1,95 @@
+#include "Evaluator.h"
+
+/* Computes the strength key of a five card hand.
+   The cards are sorted with a stable insertion sort, matching Hand::sortHand, so the card
+   picked as a tie-breaker (and therefore its suit) is the same one Hand::getTieBreakerCard picks.
+   param: ranks - int array representing the ranks of the five cards, in dealt order.
+   param: suits - int array representing the suits of the five cards, in dealt order.
+   return: int representing the strength key of the hand. */
+int Evaluator::strengthKey(const int* ranks, const int* suits) {
+    int r[5];
+    int s[5];
+
+    for (int i = 0; i < 5; i++) {
+        int rank = ranks[i];
+        int suit = suits[i];
+        int j = i;
+
+        while (j > 0 && r[j - 1] > rank) {
+            r[j] = r[j - 1];
+            s[j] = s[j - 1];
+            j--;
+        }
+
+        r[j] = rank;
+        s[j] = suit;
+    }
+
+    bool flush = s[0] == s[1] && s[1] == s[2] && s[2] == s[3] && s[3] == s[4];
+    bool straight = r[1] == r[0] + 1 && r[2] == r[1] + 1 && r[3] == r[2] + 1 && r[4] == r[3] + 1;
+
+    int type;
+    if (straight && flush && r[0] == 10 && r[4] == 14) type = 10;
+    else if (straight && flush) type = 9;
+    else if (r[0] == r[3] || r[1] == r[4]) type = 8;
+    else if ((r[0] == r[1] && r[2] == r[4]) || (r[0] == r[2] && r[3] == r[4])) type = 7;
+    else if (flush) type = 6;
+    else if (straight) type = 5;
+    else if (r[0] == r[2] || r[1] == r[3] || r[2] == r[4]) type = 4;
+    else if ((r[0] == r[1] && r[2] == r[3]) ||
+             (r[0] == r[1] && r[3] == r[4]) ||
+             (r[1] == r[2] && r[3] == r[4])) type = 3;
+    else if (r[0] == r[1] || r[1] == r[2] || r[2] == r[3] || r[3] == r[4]) type = 2;
+    else type = 1;
+
+    // Single tie-breaker card: compared by rank, then suit
+    if (type != 2 && type != 3) {
+        int c = 4;
+        if (type == 9 && r[4] == 14 && r[0] == 2) c = 3;
+        else if (type == 8 || type == 7 || type == 4) c = 2;
+
+        return packKey(type, r[c], 0, 0, s[c]);
+    }
+
+    // Kicker, as Hand::getKicker: highest card that differs from the card before it
+    int kicker = -1;
+    for (int i = 1; i < 5; i++) {
+        if (r[i] != r[i - 1] && (kicker < 0 || r[i] > r[kicker])) kicker = i;
+    }
+
+    // Two Pair: high pair rank, low pair rank, then kicker rank and suit
+    if (type == 3) {
+        int max = -1;
+        int min = -1;
+
+        for (int i = 1; i < 5; i++) {
+            if (r[i] != r[i - 1]) continue;
+            if (max < 0 || r[i] > r[max]) max = i;
+            if (min < 0 || r[i] < r[min]) min = i;
+        }
+
+        return packKey(type, r[max], r[min], r[kicker], s[kicker]);
+    }
+
+    // Pair: pair rank, kicker rank, then the highest card's rank and suit
+    int pair = 1;
+    while (r[pair] != r[pair - 1]) pair++;
+
+    return packKey(type, r[pair], r[kicker], r[4], s[4]);
+}
+
+
+/* Computes the strength key of a five card hand given as card codes.
+   param: codes - int array representing the five card codes, in dealt order.
+   return: int representing the strength key of the hand. */
+int Evaluator::codeStrengthKey(const int* codes) {
+    int ranks[5];
+    int suits[5];
+
+    for (int i = 0; i < 5; i++) {
+        ranks[i] = codeRank(codes[i]);
+        suits[i] = codeSuit(codes[i]);
+    }
+
+    return strengthKey(ranks, suits);
+}
@@ -0,0 +1,51 @@
+#ifndef EVALUATOR
+#define EVALUATOR
+
+/* Represents a fast five card hand evaluator.
+   This class reduces a hand to a single integer strength key so that comparing two keys
+   gives the same result as Hand::compareHand, without building any vectors.
+   Key layout (4 bits per field): type | rank A | rank B | rank C | suit */
+class Evaluator {
+
+public:
+
+    /* Gets the hand type stored in a strength key.
+       param: key - int representing a strength key.
+       return: int representing the hand type (1 - 10, see Hand::assessHand). */
+    static int getHandType(int key) {return key >> 16;}
+
+
+    /* Gets the primary rank stored in a strength key (pair rank, high card rank, ...).
+       param: key - int representing a strength key.
+       return: int representing the first tie-breaker rank of the hand. */
+    static int getPrimaryRank(int key) {return (key >> 12) & 15;}
+
+
+    /* Gets the rank of a card code, where code = suit * 13 + (rank - 2).
+       param: code - int representing a card code from 0 to 51.
+       return: int representing the card's rank. */
+    static int codeRank(int code) {return code % 13 + 2;}
+
+
+    /* Gets the suit of a card code, where code = suit * 13 + (rank - 2).
+       param: code - int representing a card code from 0 to 51.
+       return: int representing the card's suit. */
+    static int codeSuit(int code) {return code / 13;}
+
+
+    /* Packs a hand type and its tie-breakers into a strength key.
+       Fields are compared from left to right, the same order Hand::compareHandHelper uses its passes.
+       return: int representing the strength key. */
+    static int packKey(int type, int a, int b, int c, int suit) {
+        return (type << 16) | (a << 12) | (b << 8) | (c << 4) | suit;
+    }
+
+
+    // Outer-Defined Class Methods //
+    static int strengthKey(const int* ranks, const int* suits);
+    static int codeStrengthKey(const int* codes);
+
+};
+
+
+#endif
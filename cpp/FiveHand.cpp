@@ -1,4 +1,5 @@
 #include "FiveHand.h"
+#include <algorithm>
 #include <iostream>
 
 /* Starts a Five Hand game.
@@ -55,11 +56,7 @@ void FiveHand::play(std::string file) {
 void FiveHand::drawCards(int gameType) {
     Card temp;
     if (gameType == 0) {
-        for (int i = 0, handNum = 0; i < 30; i++, handNum++) {
-            if (handNum == 6) handNum = 0;
-            temp = deck.drawCard();
-            hands[handNum].addCard(temp);
-        }
+        for (int round = 0; round < 5; round++) drawRound();
     } else {
         for (int i = 1, handNum = 0; i <= 30; i++) {
             temp = deck.drawCard();
@@ -70,6 +67,15 @@ void FiveHand::drawCards(int gameType) {
 }
 
 
+// Draws one card for each of the 6 hands, as one round of a randomized game.
+void FiveHand::drawRound() {
+    for (Hand &hand: hands) {
+        Card temp = deck.drawCard();
+        hand.addCard(temp);
+    }
+}
+
+
 // Prints all the hands to the console.
 void FiveHand::printAllHands() {
     for (Hand &hand: hands) {
@@ -92,18 +98,21 @@ void FiveHand::sortHands() {
 }
 
 
-/* Main method for the FiveHand game.
-   Initiates the game based on command line arguments.
-   param: agrc - int representing the number of command line arguments.
-   param: argv - string array representing command line arguments.v*/
-int main(int argc, char *argv[]) {
-    std::string file = (argc > 1) ? argv[1] : "";
-    FiveHand game(file);
-    game.play(file);
-
-    return 0;
-}
-
+/* Determines the winning order with the fast evaluator, leaving the hands in dealt order.
+   Gives the same order as sortHands, whose bubble sort is also stable.
+   return: vector representing the hand indices from the winning hand down. */
+std::vector<int> FiveHand::winningOrder() {
+    std::vector<int> keys;
+    std::vector<int> order;
 
+    for (size_t i = 0; i < hands.size(); i++) {
+        keys.push_back(hands[i].getStrengthKey());
+        order.push_back(i);
+    }
 
+    std::stable_sort(order.begin(), order.end(), [&keys](int a, int b) {
+        return keys[a] > keys[b];
+    });
 
+    return order;
+}
\ No newline at end of file
@@ -1,6 +1,7 @@
 #ifndef FIVEHAND
 #define FIVEHAND
 
+#include <istream>
 #include <vector>
 #include "Card.h"
 #include "Hand.h"
@@ -33,11 +34,38 @@ public:
         else deck.buildRandDeck();
     }
 
+
+    /* Constructs a new Five Hand game with a randomized deck shuffled from a seed.
+       param: seed - unsigned long long representing the seed of the shuffle. */
+    FiveHand(unsigned long long seed) : hands(6) {
+        deck.buildSeededDeck(seed);
+    }
+
+
+    /* Constructs a new Five Hand game with a test deck read from a stream.
+       param: in - istream representing the text to build the deck from. */
+    FiveHand(std::istream& in) : hands(6) {
+        deck.buildStreamDeck(in);
+    }
+
+
+    /* Gets the six hands of the game.
+       return: vector representing the hands, in dealt or winning order. */
+    std::vector<Hand>& getHands() {return hands;}
+
+
+    /* Gets the deck of the game.
+       return: Deck representing the cards not drawn yet. */
+    Deck& getDeck() {return deck;}
+
+
     // Outer-Defined Class Methods //
     void play(std::string file);
     void drawCards(int gameType);
+    void drawRound();
     void printAllHands();
     void sortHands();
+    std::vector<int> winningOrder();
 };
 
 
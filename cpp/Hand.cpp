@@ -1,4 +1,5 @@
 #include "Hand.h"
+#include "Evaluator.h"
 #include <iostream>
 #include <algorithm>
 
@@ -51,6 +52,25 @@ int Hand::compareHand(Hand &other) {
 }
 
 
+/* Evaluates the hand with the fast evaluator and records its hand type.
+   Comparing two strength keys gives the same sign as compareHand on the two hands.
+   return: int representing the strength key of the hand. */
+int Hand::getStrengthKey() {
+    int ranks[5];
+    int suits[5];
+
+    for (size_t i = 0; i < 5; i++) {
+        ranks[i] = cards[i].getRank();
+        suits[i] = cards[i].getSuit();
+    }
+
+    int key = Evaluator::strengthKey(ranks, suits);
+    handType = Evaluator::getHandType(key);
+
+    return key;
+}
+
+
 /* Recursive helper method for the compare_hand method
    param: other - Hand representing the hands to compare to
    param: diff - int representing the difference of the hands in the current iteration
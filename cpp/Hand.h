@@ -40,10 +40,16 @@ public:
     Hand() : cards(), sorted(), handType(0) {}
 
 
+    /* Gets the cards of the hand in the order they were dealt.
+       return: vector representing the hand's cards. */
+    std::vector<Card>& getCards() {return cards;}
+
+
     // Outer-Defined Class Methods //
     void addCard(Card& card);
     std::string toString();
     int compareHand(Hand& other);
+    int getStrengthKey();
     
 };
 
@@ -0,0 +1,336 @@
+#include "Harness.h"
+#include "Random.h"
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <thread>
+
+/* Plays a number of seeded random games and compares the winning order found by
+   Hand::compareHand with the one found by the fast Evaluator, hand by hand.
+   param: count - long representing the number of games to play.
+   param: seed - unsigned long long representing the base seed of the run.
+   return: long representing the number of games that did not match. */
+long Harness::fuzz(long count, unsigned long long seed) {
+    failures = 0;
+
+    runParallel(count, [this, seed](long game) {
+        FiveHand fiveHand(Random::gameSeed(seed, game));
+        fiveHand.drawCards(0);
+
+        std::vector<Hand> dealt = fiveHand.getHands();
+        std::vector<std::string> fast = fastOrder(dealt);
+        std::vector<std::string> reference = referenceOrder(fiveHand);
+
+        if (fast != reference) report(game, "winning order", reference, fast);
+
+        // Every pair of hands must also compare with the same sign
+        for (size_t i = 0; i < dealt.size(); i++) {
+            for (size_t j = i + 1; j < dealt.size(); j++) {
+                int expected = dealt[i].compareHand(dealt[j]);
+                int actual = dealt[i].getStrengthKey() - dealt[j].getStrengthKey();
+
+                if ((expected > 0) != (actual > 0) || (expected < 0) != (actual < 0)) {
+                    std::vector<std::string> byCompare = {dealt[i].toString(), dealt[j].toString(),
+                                                          "compareHand: " + std::to_string(expected)};
+                    std::vector<std::string> byKey = {dealt[i].toString(), dealt[j].toString(),
+                                                      "key difference: " + std::to_string(actual)};
+                    report(game, "pair comparison", byCompare, byKey);
+                }
+            }
+        }
+    });
+
+    return failures;
+}
+
+
+/* Writes a number of seeded random games as test decks, the format the reference ports read.
+   Each game is written as six lines, one hand per line, followed by a blank line.
+   param: count - long representing the number of games to write.
+   param: seed - unsigned long long representing the base seed of the run.
+   param: file - string representing the file to write the decks to. */
+void Harness::generate(long count, unsigned long long seed, std::string &file) {
+    std::ofstream out(file);
+
+    if (!out.is_open()) {
+        std::cerr << "Failed to open file: " << file << std::endl;
+        return;
+    }
+
+    for (long game = 0; game < count; game++) {
+        FiveHand fiveHand(Random::gameSeed(seed, game));
+        fiveHand.drawCards(0);
+
+        for (Hand &hand: fiveHand.getHands()) {
+            out << formatHand(hand) << "\n";
+        }
+
+        out << "\n";
+    }
+
+    out.close();
+}
+
+
+/* Checks every deck of a corpus against the winning orders an oracle recorded for it.
+   Games listed as known differences must still agree between Hand::compareHand and the
+   Evaluator, and must differ from the oracle; a listed game that matches is reported so the
+   list stays exact.
+   param: decksFile - string representing the corpus written by generate.
+   param: oracleFile - string representing the winning orders recorded by a reference port.
+   param: known - map representing the known differences, game number to reason.
+   return: long representing the number of games that did not match, or -1 if the corpus and
+           oracle could not be read, are empty or do not have the same number of games. */
+long Harness::check(std::string &decksFile, std::string &oracleFile, std::map<long, std::string> &known) {
+    std::vector<std::vector<std::string>> decks;
+    std::vector<std::vector<std::string>> oracle;
+
+    if (!readRecords(decksFile, decks) || !readRecords(oracleFile, oracle)) return -1;
+
+    if (decks.empty()) {
+        std::cerr << "Corpus has no decks: " << decksFile << std::endl;
+        return -1;
+    }
+
+    if (decks.size() != oracle.size()) {
+        std::cerr << "Corpus has " << decks.size() << " decks but oracle has "
+                  << oracle.size() << " results" << std::endl;
+        return -1;
+    }
+
+    failures = 0;
+
+    runParallel(decks.size(), [this, &decks, &oracle, &known](long game) {
+        std::stringstream text;
+        for (std::string &line: decks[game]) text << line << "\n";
+
+        FiveHand fiveHand(text);
+        fiveHand.drawCards(1);
+
+        std::vector<std::string> fast = fastOrder(fiveHand.getHands());
+        std::vector<std::string> reference = referenceOrder(fiveHand);
+
+        std::map<long, std::string>::iterator it = known.find(game);
+
+        if (it == known.end()) {
+            if (reference != oracle[game]) report(game, "reference vs oracle", oracle[game], reference);
+            if (fast != oracle[game]) report(game, "evaluator vs oracle", oracle[game], fast);
+        } else {
+            if (fast != reference) report(game, "evaluator vs reference", reference, fast);
+            if (reference == oracle[game]) report(game, "known difference not seen: " + it->second,
+                                                  oracle[game], reference);
+        }
+    });
+
+    return failures;
+}
+
+
+/* Sorts the hands of a dealt game with FiveHand::sortHands and renders the winning order.
+   param: game - FiveHand representing a game whose cards have been drawn.
+   return: vector representing the hands in winning order, as printed by play. */
+std::vector<std::string> Harness::referenceOrder(FiveHand &game) {
+    std::vector<std::string> lines;
+    game.sortHands();
+
+    for (Hand &hand: game.getHands()) {
+        lines.push_back(hand.toString());
+    }
+
+    return lines;
+}
+
+
+/* Sorts hands by their strength keys and renders the winning order.
+   The sort is stable, as the bubble sort in FiveHand::sortHands is, so equal hands keep their seats.
+   param: hands - vector representing the dealt hands.
+   return: vector representing the hands in winning order, as printed by play. */
+std::vector<std::string> Harness::fastOrder(std::vector<Hand> hands) {
+    std::vector<int> keys;
+    std::vector<size_t> order;
+
+    for (size_t i = 0; i < hands.size(); i++) {
+        keys.push_back(hands[i].getStrengthKey());
+        order.push_back(i);
+    }
+
+    std::stable_sort(order.begin(), order.end(), [&keys](size_t a, size_t b) {
+        return keys[a] > keys[b];
+    });
+
+    std::vector<std::string> lines;
+    for (size_t i: order) {
+        lines.push_back(hands[i].toString());
+    }
+
+    return lines;
+}
+
+
+/* Returns a hand as one line of a test deck file.
+   param: hand - Hand representing the hand to be formatted.
+   return: string representing the hand in the test deck format. */
+std::string Harness::formatHand(Hand &hand) {
+    std::string line;
+    std::vector<Card> &cards = hand.getCards();
+
+    for (size_t i = 0; i < cards.size(); i++) {
+        if (cards[i].getRank() != 10) line += " ";
+        line += cards[i].toString();
+        if (i + 1 < cards.size()) line += ",";
+    }
+
+    return line;
+}
+
+
+/* Reads a file of blank line separated records.
+   Trailing whitespace is dropped so output captured from any of the ports compares cleanly.
+   param: file - string representing the file to be read.
+   param: records - vector set to the records, each a list of lines.
+   return: bool representing if the file could be opened. */
+bool Harness::readRecords(std::string &file, std::vector<std::vector<std::string>> &records) {
+    std::vector<std::string> record;
+    std::ifstream in(file);
+
+    records.clear();
+    if (!in.is_open()) {
+        std::cerr << "Failed to open file: " << file << std::endl;
+        return false;
+    }
+
+    std::string line;
+    while (std::getline(in, line)) {
+        line.erase(line.find_last_not_of(" \t\r") + 1);
+
+        if (!line.empty()) {
+            record.push_back(line);
+        } else if (!record.empty()) {
+            records.push_back(record);
+            record.clear();
+        }
+    }
+
+    if (!record.empty()) records.push_back(record);
+
+    return true;
+}
+
+
+/* Reads a known differences file: one game number and reason per line, "#" starting a comment.
+   param: file - string representing the file to be read.
+   return: map representing the known differences, game number to reason. */
+std::map<long, std::string> Harness::readKnown(std::string &file) {
+    std::map<long, std::string> known;
+    std::ifstream in(file);
+
+    if (!in.is_open()) {
+        std::cerr << "Failed to open file: " << file << std::endl;
+        return known;
+    }
+
+    std::string line;
+    while (std::getline(in, line)) {
+        line = line.substr(0, line.find('#'));
+
+        std::stringstream fields(line);
+        long game;
+        std::string reason;
+
+        if (fields >> game >> reason) known[game] = reason;
+    }
+
+    return known;
+}
+
+
+/* Prints a mismatch found by a worker and counts it.
+   Only the first few mismatches are printed in full.
+   param: game - long representing the game number.
+   param: what - string representing what was compared.
+   param: expected - vector representing the expected lines.
+   param: actual - vector representing the lines that were found. */
+void Harness::report(long game, std::string what, std::vector<std::string> &expected,
+                     std::vector<std::string> &actual) {
+    std::lock_guard<std::mutex> guard(reportLock);
+    failures++;
+
+    if (failures > 10) return;
+
+    std::cout << "\n*** MISMATCH in game " << game << " (" << what << ") ***\n--- expected" << std::endl;
+    for (std::string &line: expected) std::cout << line << std::endl;
+
+    std::cout << "--- actual" << std::endl;
+    for (std::string &line: actual) std::cout << line << std::endl;
+}
+
+
+/* Runs a task once for every game number, spread across the worker threads.
+   param: count - long representing the number of games.
+   param: task - function representing the work done for one game. */
+void Harness::runParallel(long count, std::function<void(long)> task) {
+    std::vector<std::thread> workers;
+
+    for (int t = 0; t < threads; t++) {
+        workers.push_back(std::thread([t, count, &task, this]() {
+            for (long game = t; game < count; game += threads) task(game);
+        }));
+    }
+
+    for (std::thread &worker: workers) worker.join();
+}
+
+
+/* Main method for the evaluator test harness.
+   Usage:
+     harness fuzz <count> [seed] [threads]
+     harness gen <count> <seed> <decks file>
+     harness check <decks file> <oracle file> [known differences file] [threads]
+   param: agrc - int representing the number of command line arguments.
+   param: argv - string array representing command line arguments. */
+int main(int argc, char *argv[]) {
+    std::string mode = (argc > 1) ? argv[1] : "";
+    int hardware = std::thread::hardware_concurrency();
+
+    if (mode == "fuzz" && argc > 2) {
+        long count = std::stol(argv[2]);
+        unsigned long long seed = (argc > 3) ? std::stoull(argv[3]) : 1;
+        Harness harness((argc > 4) ? std::stoi(argv[4]) : hardware);
+
+        long failed = harness.fuzz(count, seed);
+        std::cout << "\n*** " << count << " games, " << failed << " mismatches ***" << std::endl;
+        return failed == 0 ? 0 : 1;
+    }
+
+    if (mode == "gen" && argc > 4) {
+        std::string file = argv[4];
+        Harness harness(1);
+        harness.generate(std::stol(argv[2]), std::stoull(argv[3]), file);
+        return 0;
+    }
+
+    if (mode == "check" && argc > 3) {
+        std::string decks = argv[2];
+        std::string oracle = argv[3];
+        std::string knownFile = (argc > 4) ? argv[4] : "";
+        std::map<long, std::string> known;
+        Harness harness((argc > 5) ? std::stoi(argv[5]) : hardware);
+
+        if (!knownFile.empty()) {
+            known = Harness::readKnown(knownFile);
+            if (known.empty()) return 2;
+        }
+
+        long failed = harness.check(decks, oracle, known);
+        if (failed < 0) return 1;
+
+        std::cout << "\n*** " << failed << " mismatches, " << known.size() << " known differences ***" << std::endl;
+        return failed == 0 ? 0 : 1;
+    }
+
+    std::cerr << "usage: harness fuzz <count> [seed] [threads]\n"
+              << "       harness gen <count> <seed> <decks file>\n"
+              << "       harness check <decks file> <oracle file> [known differences file] [threads]" << std::endl;
+    return 2;
+}
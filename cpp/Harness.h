@@ -0,0 +1,47 @@
+#ifndef HARNESS
+#define HARNESS
+
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "Hand.h"
+#include "FiveHand.h"
+
+/* Represents the differential test harness for the hand evaluator.
+   Random seeded decks are evaluated in-process with both Hand::compareHand and the fast
+   Evaluator, and can be checked against an oracle corpus produced by the reference ports. */
+class Harness {
+
+private:
+
+    int threads;
+    long failures;
+    std::mutex reportLock;
+
+    // Outer-Defined Class Methods //
+    void report(long game, std::string what, std::vector<std::string>& expected, std::vector<std::string>& actual);
+    void runParallel(long count, std::function<void(long)> task);
+
+public:
+
+    /* Constructs a new harness that spreads its work across the given number of threads.
+       param: t - int representing the number of worker threads. */
+    Harness(int t) : threads(t < 1 ? 1 : t), failures(0) {}
+
+
+    // Outer-Defined Class Methods //
+    long fuzz(long count, unsigned long long seed);
+    void generate(long count, unsigned long long seed, std::string& file);
+    long check(std::string& decksFile, std::string& oracleFile, std::map<long, std::string>& known);
+    static std::vector<std::string> referenceOrder(FiveHand& game);
+    static std::vector<std::string> fastOrder(std::vector<Hand> hands);
+    static std::string formatHand(Hand& hand);
+    static bool readRecords(std::string& file, std::vector<std::vector<std::string>>& records);
+    static std::map<long, std::string> readKnown(std::string& file);
+
+};
+
+
+#endif
@@ -0,0 +1,13 @@
+#include "FiveHand.h"
+
+/* Main method for the FiveHand game.
+   Initiates the game based on command line arguments.
+   param: agrc - int representing the number of command line arguments.
+   param: argv - string array representing command line arguments.v*/
+int main(int argc, char *argv[]) {
+    std::string file = (argc > 1) ? argv[1] : "";
+    FiveHand game(file);
+    game.play(file);
+
+    return 0;
+}
@@ -0,0 +1,408 @@
+#include "Matchup.h"
+#include "Card.h"
+#include "Dispatch.h"
+#include "Evaluator.h"
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+
+// Rows per band and columns per tile; one tile of keys and masks stays in L1/L2 while it is swept
+static const size_t BAND_ROWS = 256;
+static const size_t TILE_COLS = 2048;
+
+// Most memory spent on band buffers waiting to be written out
+static const size_t MAX_BUFFERED = 256 << 20;
+
+
+/* Compares one row hand against a run of column hands.
+   Branch-free apart from the optional cell store, which the compiler unswitches out of the loop.
+   The card mask test needs 64 bit vector compares, so the loop only vectorizes for SSE4.1 and up:
+   the AVX2/AVX-512 clones (FIVEHAND_DISPATCH, on by default) or FIVEHAND_MARCH=x86-64-v2 or later.
+   param: key - int representing the row hand's strength key.
+   param: mask - unsigned long long representing the row hand's cards.
+   param: colKeys - int array representing the column hands' strength keys.
+   param: colMasks - unsigned long long array representing the column hands' cards.
+   param: cols - size_t representing the number of column hands.
+   param: cells - signed char array set to the results, or NULL if not kept.
+   param: totals - long long array to add the wins, losses and shared counts to. */
+HOT_CLONES static void sweepRow(int key, unsigned long long mask, const int* colKeys,
+                                const unsigned long long* colMasks, size_t cols, signed char* cells,
+                                long long* totals) {
+    long long wins = 0, losses = 0, shared = 0;
+
+    for (size_t c = 0; c < cols; c++) {
+        int blocked = (mask & colMasks[c]) != 0;
+        int win = !blocked & (key > colKeys[c]);
+        int lose = !blocked & (key < colKeys[c]);
+
+        wins += win;
+        losses += lose;
+        shared += blocked;
+        if (cells != NULL) cells[c] = static_cast<signed char>(blocked ? 2 : win - lose);
+    }
+
+    totals[0] += wins;
+    totals[1] += losses;
+    totals[2] += shared;
+}
+
+
+/* Adds every five card hand matching a spec to a new range.
+   A spec is a hand type with an optional minimum primary rank, e.g. "pair:J", "flush", "two-pair:10".
+   Each hand's cards are taken in ascending card code order (see Evaluator::codeRank).
+   param: spec - string representing the range to add.
+   return: bool representing if the spec was valid. */
+bool Matchup::addRange(std::string spec) {
+    size_t colon = spec.find(':');
+    int type = parseType(spec.substr(0, colon));
+    int minRank = 2;
+
+    if (colon != std::string::npos) {
+        std::string r = spec.substr(colon + 1);
+        if (r == "J") minRank = 11;
+        else if (r == "Q") minRank = 12;
+        else if (r == "K") minRank = 13;
+        else if (r == "A") minRank = 14;
+        else minRank = std::atoi(r.c_str());
+    }
+
+    if (type < 0 || minRank < 2 || minRank > 14) {
+        std::cerr << "Invalid hand range: " << spec << std::endl;
+        return false;
+    }
+
+    std::vector<int> rangeKeys;
+    std::vector<unsigned long long> rangeMasks;
+    std::vector<unsigned char> rangeCodes;
+
+    int c[5];
+    for (c[0] = 0; c[0] < 52; c[0]++)
+    for (c[1] = c[0] + 1; c[1] < 52; c[1]++)
+    for (c[2] = c[1] + 1; c[2] < 52; c[2]++)
+    for (c[3] = c[2] + 1; c[3] < 52; c[3]++)
+    for (c[4] = c[3] + 1; c[4] < 52; c[4]++) {
+        int key = Evaluator::codeStrengthKey(c);
+
+        if (type != 0 && Evaluator::getHandType(key) != type) continue;
+        if (Evaluator::getPrimaryRank(key) < minRank) continue;
+
+        unsigned long long mask = 0;
+        for (int i = 0; i < 5; i++) {
+            mask |= 1ULL << c[i];
+            rangeCodes.push_back(c[i]);
+        }
+
+        rangeKeys.push_back(key);
+        rangeMasks.push_back(mask);
+    }
+
+    names.push_back(spec);
+    keys.push_back(rangeKeys);
+    masks.push_back(rangeMasks);
+    codes.push_back(rangeCodes);
+
+    return true;
+}
+
+
+/* Computes the matrix of one range against another and prints the aggregate results.
+   The matrix is split into items of one band of rows by one tile of columns, which a single
+   set of worker threads takes in order. When the matrix is kept, finished bands are written
+   in order by this thread while the workers carry on with the following bands.
+   param: a - int representing the index of the row range.
+   param: b - int representing the index of the column range.
+   param: csvFile - string representing the CSV file to write the matrix to, or empty.
+   param: binFile - string representing the binary file to write the matrix to, or empty.
+   param: verify - bool representing if every cell is checked against Hand::compareHand.
+   return: long representing the number of cells that did not match Hand::compareHand. */
+long Matchup::compare(int a, int b, std::string csvFile, std::string binFile, bool verify) {
+    size_t rowCount = keys[a].size();
+    size_t colCount = keys[b].size();
+    size_t bands = (rowCount + BAND_ROWS - 1) / BAND_ROWS;
+    size_t tiles = (colCount + TILE_COLS - 1) / TILE_COLS;
+    bool output = !csvFile.empty() || !binFile.empty() || verify;
+    long mismatches = 0;
+
+    std::ofstream csv;
+    if (!csvFile.empty()) {
+        csv.open(csvFile);
+        for (size_t col = 0; col < colCount; col++) csv << "," << handLabel(b, col);
+        csv << "\n";
+    }
+
+    // Binary layout: "FHMX", rows, cols (uint32), row cards, column cards (5 codes each), cells (int8)
+    std::ofstream bin;
+    if (!binFile.empty()) {
+        bin.open(binFile, std::ios::binary);
+        unsigned int dims[2] = {static_cast<unsigned int>(rowCount), static_cast<unsigned int>(colCount)};
+        bin.write("FHMX", 4);
+        bin.write(reinterpret_cast<char*>(dims), sizeof(dims));
+        bin.write(reinterpret_cast<char*>(codes[a].data()), codes[a].size());
+        bin.write(reinterpret_cast<char*>(codes[b].data()), codes[b].size());
+    }
+
+    // Enough band buffers to keep every worker busy while a band is written, within MAX_BUFFERED
+    size_t window = 0;
+    if (output) {
+        size_t fit = MAX_BUFFERED / std::max<size_t>(BAND_ROWS * colCount, 1);
+        window = std::max<size_t>(1, std::min<size_t>(threads + 1, fit));
+    }
+
+    nextItem = 0;
+    bandsWritten = 0;
+    bandCells.assign(window, std::vector<signed char>(BAND_ROWS * colCount));
+    tilesDone.assign(window, 0);
+
+    std::vector<long long> totals(threads * 3, 0);
+    std::vector<std::thread> workers;
+
+    for (int t = 0; t < threads; t++) {
+        workers.push_back(std::thread(&Matchup::sweepTiles, this, a, b, bands * tiles, &totals[t * 3]));
+    }
+
+    for (size_t band = 0; band < bands && output; band++) {
+        size_t row = band * BAND_ROWS;
+        size_t rows = std::min(BAND_ROWS, rowCount - row);
+        std::vector<signed char> &cells = bandCells[band % window];
+
+        {
+            std::unique_lock<std::mutex> guard(bandLock);
+            bandDone.wait(guard, [this, band, window, tiles]() {return tilesDone[band % window] == tiles;});
+        }
+
+        for (size_t r = 0; r < rows && csv.is_open(); r++) {
+            csv << handLabel(a, row + r);
+            for (size_t col = 0; col < colCount; col++) csv << "," << int(cells[r * colCount + col]);
+            csv << "\n";
+        }
+
+        if (bin.is_open()) bin.write(reinterpret_cast<char*>(cells.data()), rows * colCount);
+        if (verify) mismatches += verifyBand(a, b, row, rows, cells);
+
+        {
+            std::lock_guard<std::mutex> guard(bandLock);
+            tilesDone[band % window] = 0;
+            bandsWritten++;
+        }
+        bandFree.notify_all();
+    }
+
+    for (std::thread &worker: workers) worker.join();
+    bandCells.clear();
+
+    long long wins = 0, losses = 0, shared = 0;
+    for (int t = 0; t < threads; t++) {
+        wins += totals[t * 3];
+        losses += totals[t * 3 + 1];
+        shared += totals[t * 3 + 2];
+    }
+
+    long long cells = static_cast<long long>(rowCount) * colCount;
+    long long ties = cells - wins - losses - shared;
+    double played = (cells - shared > 0) ? double(cells - shared) : 1.0;
+
+    std::cout << "\n*** " << names[a] << " (" << rowCount << " hands) vs "
+              << names[b] << " (" << colCount << " hands) ***\n" << std::fixed << std::setprecision(4)
+              << "  Wins:   " << wins << " (" << 100.0 * wins / played << "%)\n"
+              << "  Losses: " << losses << " (" << 100.0 * losses / played << "%)\n"
+              << "  Ties:   " << ties << " (" << 100.0 * ties / played << "%)\n"
+              << "  Shared: " << shared << " (matchups sharing a card, not played)" << std::endl;
+
+    if (verify) {
+        std::cout << "*** " << mismatches << " cells did not match Hand::compareHand ***" << std::endl;
+    }
+
+    return mismatches;
+}
+
+
+/* Checks one band of the matrix against Hand objects compared with Hand::compareHand,
+   and against the hands' cards for the shared cells. Prints the first few cells that differ.
+   param: a - int representing the index of the row range.
+   param: b - int representing the index of the column range.
+   param: row - size_t representing the band's first row.
+   param: rows - size_t representing the number of rows in the band.
+   param: cells - signed char vector representing the band's cells, rows * columns.
+   return: long representing the number of cells that did not match. */
+long Matchup::verifyBand(int a, int b, size_t row, size_t rows, std::vector<signed char>& cells) {
+    size_t colCount = keys[b].size();
+    long mismatches = 0;
+
+    for (size_t r = 0; r < rows; r++) {
+        Hand rowHand = rangeHand(a, row + r);
+
+        for (size_t col = 0; col < colCount; col++) {
+            int expected = 2;
+
+            if ((masks[a][row + r] & masks[b][col]) == 0) {
+                Hand colHand = rangeHand(b, col);
+                int diff = rowHand.compareHand(colHand);
+                expected = (diff > 0) - (diff < 0);
+            }
+
+            int actual = cells[r * colCount + col];
+            if (actual == expected) continue;
+
+            if (mismatches++ < 10) {
+                std::cerr << handLabel(a, row + r) << " vs " << handLabel(b, col) << ": matrix "
+                          << actual << ", compareHand " << expected << std::endl;
+            }
+        }
+    }
+
+    return mismatches;
+}
+
+
+/* Builds a Hand holding the cards of a hand in a range.
+   param: range - int representing the range's index.
+   param: hand - size_t representing the hand's index within the range.
+   return: Hand representing the hand's cards. */
+Hand Matchup::rangeHand(int range, size_t hand) {
+    Hand result;
+
+    for (size_t i = 0; i < 5; i++) {
+        int code = codes[range][hand * 5 + i];
+        Card card(Evaluator::codeRank(code), Evaluator::codeSuit(code));
+        result.addCard(card);
+    }
+
+    return result;
+}
+
+
+/* Worker thread: sweeps (band, tile) items, taken in order, until every item is done.
+   When the matrix is kept, an item waits for its band's buffer to be free and marks its tile
+   done once its cells are stored.
+   param: a - int representing the index of the row range.
+   param: b - int representing the index of the column range.
+   param: items - size_t representing the number of items, bands times tiles.
+   param: totals - long long array representing the thread's wins, losses and shared counts. */
+void Matchup::sweepTiles(int a, int b, size_t items, long long* totals) {
+    const int* rowKeys = keys[a].data();
+    const unsigned long long* rowMasks = masks[a].data();
+    const int* colKeys = keys[b].data();
+    const unsigned long long* colMasks = masks[b].data();
+    size_t rowCount = keys[a].size();
+    size_t colCount = keys[b].size();
+    size_t tiles = (colCount + TILE_COLS - 1) / TILE_COLS;
+    size_t window = bandCells.size();
+
+    while (true) {
+        size_t item = nextItem++;
+        if (item >= items) return;
+
+        size_t band = item / tiles;
+        size_t row = band * BAND_ROWS;
+        size_t col = (item % tiles) * TILE_COLS;
+        size_t rows = std::min(BAND_ROWS, rowCount - row);
+        size_t cols = std::min(TILE_COLS, colCount - col);
+        signed char* cells = NULL;
+
+        if (window > 0) {
+            std::unique_lock<std::mutex> guard(bandLock);
+            bandFree.wait(guard, [this, band, window]() {return band < bandsWritten + window;});
+            cells = bandCells[band % window].data() + col;
+        }
+
+        for (size_t r = 0; r < rows; r++) {
+            sweepRow(rowKeys[row + r], rowMasks[row + r], colKeys + col, colMasks + col, cols,
+                     cells != NULL ? cells + r * colCount : NULL, totals);
+        }
+
+        if (window > 0) {
+            std::lock_guard<std::mutex> guard(bandLock);
+            if (++tilesDone[band % window] == tiles) bandDone.notify_one();
+        }
+    }
+}
+
+
+/* Returns the cards of a hand in a range as a label, e.g. " AH  KH  QH  JH 10H".
+   param: range - int representing the range's index.
+   param: hand - size_t representing the hand's index within the range.
+   return: string representing the hand's cards. */
+std::string Matchup::handLabel(int range, size_t hand) {
+    std::string label;
+
+    for (size_t i = 0; i < 5; i++) {
+        int code = codes[range][hand * 5 + i];
+        Card card(Evaluator::codeRank(code), Evaluator::codeSuit(code));
+
+        if (i > 0) label += " ";
+        label += card.toString();
+    }
+
+    return label;
+}
+
+
+/* Returns the hand type named in a range spec.
+   param: name - string representing the hand type, e.g. "full-house", or "any".
+   return: int representing the hand type (see Hand::assessHand), 0 for any, -1 if unknown. */
+int Matchup::parseType(std::string name) {
+    if (name == "any") return 0;
+    if (name == "royal-straight-flush") return 10;
+    if (name == "straight-flush") return 9;
+    if (name == "four-of-a-kind") return 8;
+    if (name == "full-house") return 7;
+    if (name == "flush") return 6;
+    if (name == "straight") return 5;
+    if (name == "three-of-a-kind") return 4;
+    if (name == "two-pair") return 3;
+    if (name == "pair") return 2;
+    if (name == "high-card") return 1;
+    return -1;
+}
+
+
+/* Main method for the matchup engine.
+   Usage: matchup [-t threads] [-csv file] [-bin file] [-verify] <range> <range> [range...]
+   Every range is compared against every later range. With more than two ranges,
+   "_<a>v<b>" is added to the output file names. With -verify, every cell is also checked against
+   Hand::compareHand, and the exit status is 1 if any did not match.
+   param: agrc - int representing the number of command line arguments.
+   param: argv - string array representing command line arguments. */
+int main(int argc, char *argv[]) {
+    int threads = std::thread::hardware_concurrency();
+    std::string csvFile;
+    std::string binFile;
+    std::vector<std::string> specs;
+    bool verify = false;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "-t" && i + 1 < argc) threads = std::atoi(argv[++i]);
+        else if (arg == "-csv" && i + 1 < argc) csvFile = argv[++i];
+        else if (arg == "-bin" && i + 1 < argc) binFile = argv[++i];
+        else if (arg == "-verify") verify = true;
+        else specs.push_back(arg);
+    }
+
+    if (specs.size() < 2) {
+        std::cerr << "usage: matchup [-t threads] [-csv file] [-bin file] [-verify] <range> <range> [range...]\n"
+                  << "  range: <type>[:<min rank>], type is one of any, high-card, pair, two-pair,\n"
+                  << "         three-of-a-kind, straight, flush, full-house, four-of-a-kind,\n"
+                  << "         straight-flush, royal-straight-flush (e.g. pair:J)" << std::endl;
+        return 2;
+    }
+
+    Matchup matchup(threads);
+    for (std::string &spec: specs) {
+        if (!matchup.addRange(spec)) return 2;
+    }
+
+    long mismatches = 0;
+    for (size_t a = 0; a < specs.size(); a++) {
+        for (size_t b = a + 1; b < specs.size(); b++) {
+            std::string suffix = (specs.size() > 2) ? "_" + std::to_string(a) + "v" + std::to_string(b) : "";
+            mismatches += matchup.compare(a, b, csvFile.empty() ? "" : csvFile + suffix,
+                                          binFile.empty() ? "" : binFile + suffix, verify);
+        }
+    }
+
+    return mismatches > 0 ? 1 : 0;
+}
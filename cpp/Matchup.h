@@ -0,0 +1,63 @@
+#ifndef MATCHUP
+#define MATCHUP
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "Hand.h"
+
+/* Represents a hand-range versus hand-range matchup engine.
+   Each range is every five card hand matching a spec such as "pair:J" (pairs of jacks or better)
+   or "flush". Strength keys are computed once per hand into contiguous arrays, then every pair
+   of ranges is swept band by tile across a set of worker threads, giving the win/lose matrix that
+   Hand::compareHand would give, without building any Hand objects.
+   Matrix cells are 1 (row hand wins), -1 (row hand loses), 0 (tie) or 2 (the hands share a card). */
+class Matchup {
+
+private:
+
+    int threads;
+    std::vector<std::string> names;
+    std::vector<std::vector<int>> keys;
+    std::vector<std::vector<unsigned long long>> masks;
+    std::vector<std::vector<unsigned char>> codes;
+
+    // Sweep state shared by the workers of one comparison
+    std::atomic<size_t> nextItem;
+    std::mutex bandLock;
+    std::condition_variable bandDone;
+    std::condition_variable bandFree;
+    std::vector<std::vector<signed char>> bandCells;
+    std::vector<size_t> tilesDone;
+    size_t bandsWritten;
+
+    // Outer-Defined Class Methods //
+    void sweepTiles(int a, int b, size_t items, long long* totals);
+    long verifyBand(int a, int b, size_t row, size_t rows, std::vector<signed char>& cells);
+    std::string handLabel(int range, size_t hand);
+    Hand rangeHand(int range, size_t hand);
+
+public:
+
+    /* Constructs a new matchup engine that spreads its work across the given number of threads.
+       param: t - int representing the number of worker threads. */
+    Matchup(int t) : threads(t < 1 ? 1 : t), names(), keys(), masks(), codes(), nextItem(0), bandsWritten(0) {}
+
+
+    /* Gets the number of hands in a range.
+       param: range - int representing the range's index.
+       return: size_t representing the number of hands. */
+    size_t getSize(int range) {return keys[range].size();}
+
+
+    // Outer-Defined Class Methods //
+    bool addRange(std::string spec);
+    long compare(int a, int b, std::string csvFile, std::string binFile, bool verify);
+    static int parseType(std::string name);
+
+};
+
+
+#endif
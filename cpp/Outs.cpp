@@ -0,0 +1,404 @@
+#include "Outs.h"
+#include "Evaluator.h"
+#include <algorithm>
+#include <cstring>
+#include <map>
+
+std::vector<int> Outs::transitions;
+std::vector<int> Outs::stateKeys;
+std::vector<int> Outs::flushKeys;
+std::once_flag Outs::tablesBuilt;
+
+// Flush state of the cards so far: a suit (0 - 3) if they all share it, NO_FLUSH if not
+static const int NO_FLUSH = -1;
+static const int ANY_SUIT = 4;
+
+// A five card state's entry in stateKeys: its strength key without the suit, and the tie card above it
+static const int KEY_BITS = 0xFFFFF0;
+static const int TIE_SHIFT = 24;
+
+
+/* Unpacks a deck card stored by the constructor as code << 6 | suit << 4 | rank.
+   param: card - int representing the packed card.
+   return: int representing the card's rank, suit or code. */
+static inline int packedRank(int card) {return card & 15;}
+static inline int packedSuit(int card) {return (card >> 4) & 3;}
+static inline int packedCode(int card) {return card >> 6;}
+
+
+/* Constructs a new analysis of a partial hand against the cards left in a deck.
+   param: hand - Hand representing the partial hand, in dealt order.
+   param: deck - Deck representing the cards that can complete the hand, next card first. */
+Outs::Outs(Hand &hand, Deck &deck) : Outs() {
+    load(hand, deck);
+}
+
+
+/* Loads a partial hand and the cards left in a deck, replacing the previous ones.
+   param: hand - Hand representing the partial hand, in dealt order.
+   param: deck - Deck representing the cards that can complete the hand, next card first. */
+void Outs::load(Hand &hand, Deck &deck) {
+    partial.clear();
+    remaining.clear();
+    deckCards.clear();
+
+    for (Card &card: hand.getCards()) partial.push_back(card.getCode());
+
+    for (Card &card: deck.getCards()) {
+        int code = card.getCode();
+        remaining.push_back(code);
+        deckCards.push_back(code << 6 | Evaluator::codeSuit(code) << 4 | Evaluator::codeRank(code));
+    }
+}
+
+
+/* Builds the shared rank-count tables now rather than in the first analysis,
+   so the first analysis takes no longer than the others. */
+void Outs::prepare() {
+    std::call_once(tablesBuilt, buildTables);
+}
+
+
+/* Loads a partial hand and the cards left in a deck, then evaluates every completion.
+   The output buffers of the previous analysis are reused, so a caller analyzing many hands
+   (every seat of every deal) only allocates them while they still need to grow.
+   param: hand - Hand representing the partial hand, in dealt order.
+   param: deck - Deck representing the cards that can complete the hand, next card first. */
+void Outs::analyze(Hand &hand, Deck &deck) {
+    load(hand, deck);
+    analyze();
+}
+
+
+/* Sets up the output buffers for hands missing the given number of cards, and touches them,
+   so the first analysis of that size neither allocates nor waits for fresh memory.
+   param: missing - int representing the number of cards missing from the hand (1 - 5).
+   param: deckSize - int representing the number of cards left in the deck. */
+void Outs::reserve(int missing, int deckSize) {
+    long combinations = 1;
+    for (int i = 0; i < missing; i++) combinations = combinations * (deckSize - i) / (i + 1);
+
+    grow(combinations, missing);
+    std::fill(keys.get(), keys.get() + keyCapacity, 0);
+    std::fill(added.get(), added.get() + addedCapacity, 0);
+    stateCounts.assign(stateKeys.size(), 0);
+}
+
+
+/* Grows the output buffers, uninitialized, to hold the given number of completions.
+   finish always stores four bytes of added cards, so added has room past the last completion.
+   param: combinations - long representing the number of completions.
+   param: missing - int representing the number of cards each completion adds. */
+void Outs::grow(long combinations, int missing) {
+    if (combinations > keyCapacity) {
+        keys.reset(new int[combinations]);
+        keyCapacity = combinations;
+    }
+
+    if (combinations * missing + 4 > addedCapacity) {
+        added.reset(new unsigned char[combinations * missing + 4]);
+        addedCapacity = combinations * missing + 4;
+    }
+}
+
+
+/* Evaluates every completion of the hand and counts the hand types reached.
+   Completions are written in place into buffers with room for every combination of the
+   missing cards; they are left uninitialized, since only the completions found are read. */
+void Outs::analyze() {
+    prepare();
+
+    typeCounts.assign(11, 0);
+    stateCounts.assign(stateKeys.size(), 0);
+    filled = 0;
+
+    if (partial.size() > 5) return;
+
+    for (int rank = 0; rank < 15; rank++) nextSlot[rank] = rank * 4;
+
+    int state = 0;
+    int flushSuit = ANY_SUIT;
+    unsigned long long seen = 0;
+
+    for (int code: partial) {
+        int rank = Evaluator::codeRank(code);
+        int suit = Evaluator::codeSuit(code);
+
+        // A card held twice can also make five of one rank, which has no transition
+        if (seen & (1ULL << code)) return;
+        seen |= 1ULL << code;
+
+        state = transitions[state * 13 + rank - 2];
+        if (state < 0) return;
+
+        suitsByCard[nextSlot[rank]++] = suit;
+        flushSuit = (flushSuit == ANY_SUIT || flushSuit == suit) ? suit : NO_FLUSH;
+    }
+
+    need = 5 - partial.size();
+    long combinations = 1;
+    for (int i = 0; i < need; i++) combinations = combinations * (remaining.size() - i) / (i + 1);
+
+    grow(combinations, need);
+
+    if (need == 4) extendFour(state, flushSuit);
+    else extend(need, 0, state, flushSuit);
+
+    for (size_t id = 0; id < stateCounts.size(); id++) {
+        if (stateCounts[id] > 0) typeCounts[Evaluator::getHandType(stateKeys[id] & KEY_BITS)] += stateCounts[id];
+    }
+}
+
+
+/* Adds one more card from the deck, in every possible way, then recurses for the rest.
+   param: depth - int representing the number of cards still missing.
+   param: start - size_t representing the first deck position that may be used.
+   param: state - int representing the rank-count state of the cards so far.
+   param: flushSuit - int representing the flush state of the cards so far. */
+void Outs::extend(int depth, size_t start, int state, int flushSuit) {
+    if (depth == 0) {
+        int key;
+        if (flushSuit >= 0 && flushSuit != ANY_SUIT) {
+            key = flushKeys[state] | flushSuit;
+        } else {
+            key = (stateKeys[state] & KEY_BITS) | suitsByCard[stateKeys[state] >> TIE_SHIFT];
+        }
+
+        keys[filled++] = key;
+        typeCounts[Evaluator::getHandType(key)]++;
+        return;
+    }
+
+    if (depth == 1) {
+        finish(start, state, flushSuit);
+        return;
+    }
+
+    for (size_t i = start; i + depth <= remaining.size(); i++) {
+        int rank = packedRank(deckCards[i]);
+        int suit = packedSuit(deckCards[i]);
+        int next = transitions[state * 13 + rank - 2];
+
+        if (next < 0) continue;
+
+        suitsByCard[nextSlot[rank]++] = suit;
+        picked[need - depth] = remaining[i];
+
+        extend(depth - 1, i + 1, next, (flushSuit == ANY_SUIT || flushSuit == suit) ? suit : NO_FLUSH);
+
+        nextSlot[rank]--;
+    }
+}
+
+
+/* Adds four cards from the deck in every possible way: the one card hands of the first round.
+   The same walk as extend, written as nested loops since it covers ~160k completions per hand.
+   param: state - int representing the rank-count state of the dealt card.
+   param: flushSuit - int representing the flush state of the dealt card. */
+void Outs::extendFour(int state, int flushSuit) {
+    size_t n = remaining.size();
+
+    for (size_t a = 0; a + 4 <= n; a++) {
+        int rankA = packedRank(deckCards[a]);
+        int suitA = packedSuit(deckCards[a]);
+        int stateA = transitions[state * 13 + rankA - 2];
+        if (stateA < 0) continue;
+
+        int flushA = (flushSuit == ANY_SUIT || flushSuit == suitA) ? suitA : NO_FLUSH;
+        suitsByCard[nextSlot[rankA]++] = suitA;
+        picked[0] = remaining[a];
+
+        for (size_t b = a + 1; b + 3 <= n; b++) {
+            int rankB = packedRank(deckCards[b]);
+            int suitB = packedSuit(deckCards[b]);
+            int stateB = transitions[stateA * 13 + rankB - 2];
+            if (stateB < 0) continue;
+
+            int flushB = (flushA == suitB) ? suitB : NO_FLUSH;
+            suitsByCard[nextSlot[rankB]++] = suitB;
+            picked[1] = remaining[b];
+
+            for (size_t c = b + 1; c + 2 <= n; c++) {
+                int rankC = packedRank(deckCards[c]);
+                int suitC = packedSuit(deckCards[c]);
+                int stateC = transitions[stateB * 13 + rankC - 2];
+                if (stateC < 0) continue;
+
+                suitsByCard[nextSlot[rankC]++] = suitC;
+                picked[2] = remaining[c];
+
+                finish(c + 1, stateC, (flushB == suitC) ? suitC : NO_FLUSH);
+
+                nextSlot[rankC]--;
+            }
+
+            nextSlot[rankB]--;
+        }
+
+        nextSlot[rankA]--;
+    }
+}
+
+
+/* Adds the last missing card from the deck in every possible way and stores each completion.
+   param: start - size_t representing the first deck position that may be used.
+   param: state - int representing the rank-count state of the other four cards.
+   param: flushSuit - int representing the flush state of the other four cards. */
+void Outs::finish(size_t start, int state, int flushSuit) {
+    // Everything the loop reads is held in locals: its byte stores could otherwise alias any member
+    const int* next = transitions.data() + state * 13 - 2;
+    const int* flushKey = flushKeys.data();
+    const int* stateKey = stateKeys.data();
+    const unsigned short* deck = deckCards.data();
+    int* suitOf = suitsByCard;
+    const int* slot = nextSlot;
+    int* out = keys.get() + filled;
+    unsigned char* card = added.get() + filled * need;
+    long* counts = typeCounts.data();
+    int* byState = stateCounts.data();
+    int stride = need;
+    int last = need - 1;
+    size_t n = remaining.size();
+
+    // The cards picked so far are stored as one word, then the last card over its byte
+    unsigned int prefix;
+    std::memcpy(&prefix, picked, 4);
+
+    // With four cards picked the flush state is a suit or NO_FLUSH, never ANY_SUIT
+    for (size_t i = start; i < n; i++) {
+        int rank = packedRank(deck[i]);
+        int suit = packedSuit(deck[i]);
+        int full = next[rank];
+        if (full < 0) continue;
+
+        // The added card's suit is only read if it breaks a tie, so its slot is not taken
+        // Most completions are counted by rank state: consecutive ones rarely share a counter,
+        // where counting by type would chain every increment on the same few counters
+        int key;
+        if (flushSuit == suit) {
+            key = flushKey[full] | suit;
+            counts[Evaluator::getHandType(key)]++;
+        } else {
+            suitOf[slot[rank]] = suit;
+            int entry = stateKey[full];
+            key = (entry & KEY_BITS) | suitOf[entry >> TIE_SHIFT];
+            byState[full]++;
+        }
+
+        *out++ = key;
+
+        // Four bytes are always stored; added has room past its end for the last completion
+        std::memcpy(card, &prefix, 4);
+        card[last] = packedCode(deck[i]);
+        card += stride;
+    }
+
+    filled = out - keys.get();
+}
+
+
+/* Gets the number of ways the hand can be completed.
+   return: long representing the number of completions. */
+long Outs::getCompletions() {
+    return filled;
+}
+
+
+/* Gets the strength key of one completion.
+   param: completion - long representing the completion.
+   return: int representing the strength key of the completed hand. */
+int Outs::getKey(long completion) {
+    return keys[completion];
+}
+
+
+/* Gets one of the cards a completion adds to the hand.
+   param: completion - long representing the completion.
+   param: card - int representing which added card, in the order drawn.
+   return: int representing the card code (see Card::getCode). */
+int Outs::getAddedCard(long completion, int card) {
+    return added[completion * need + card];
+}
+
+
+/* Gets the chance of the completed hand being of a given type.
+   param: type - int representing the hand type (1 - 10, see Hand::assessHand).
+   return: double representing the share of completions of that type. */
+double Outs::getProbability(int type) {
+    return filled == 0 ? 0.0 : double(typeCounts[type]) / filled;
+}
+
+
+/* Builds the rank-count tables.
+   A state is a multiset of up to five ranks (at most four of each). transitions[state * 13 + rank - 2]
+   is the state after adding a card of that rank, or -1. Each five card state stores in stateKeys its
+   strength key without the suit, and above it (TIE_SHIFT) which card's suit completes the key:
+   rank * 4 + n, the n-th card of that rank in dealt order, its index in suitsByCard. The keys are
+   found by Evaluator itself, given the sorted ranks and the sorted positions in place of suits,
+   so the suit field comes back as the tie-breaker's position. */
+void Outs::buildTables() {
+    std::map<unsigned long long, int> ids;
+    std::vector<std::vector<int>> counts;
+
+    counts.push_back(std::vector<int>(13, 0));
+    ids[0] = 0;
+
+    for (size_t id = 0; id < counts.size(); id++) {
+        int size = 0;
+        for (int n: counts[id]) size += n;
+
+        for (int r = 0; r < 13; r++) {
+            if (size == 5 || counts[id][r] == 4) {
+                transitions.push_back(-1);
+                continue;
+            }
+
+            std::vector<int> next = counts[id];
+            next[r]++;
+
+            unsigned long long code = 0;
+            for (int n: next) code = code * 5 + n;
+
+            std::map<unsigned long long, int>::iterator it = ids.find(code);
+            if (it == ids.end()) {
+                it = ids.insert(std::make_pair(code, (int) counts.size())).first;
+                counts.push_back(next);
+            }
+
+            transitions.push_back(it->second);
+        }
+    }
+
+    stateKeys.assign(counts.size(), -1);
+    flushKeys.assign(counts.size(), -1);
+
+    for (size_t id = 0; id < counts.size(); id++) {
+        int ranks[5];
+        int positions[5] = {0, 1, 2, 3, 4};
+        int size = 0;
+
+        for (int r = 0; r < 13; r++) {
+            for (int n = 0; n < counts[id][r] && size < 5; n++) ranks[size++] = r + 2;
+        }
+
+        if (size != 5) continue;
+
+        int key = Evaluator::strengthKey(ranks, positions);
+        int type = Evaluator::getHandType(key);
+        int tie = key & 15;
+        int first = tie;
+        while (first > 0 && ranks[first - 1] == ranks[tie]) first--;
+
+        stateKeys[id] = (key & KEY_BITS) | (ranks[tie] * 4 + (tie - first)) << TIE_SHIFT;
+
+        // All five cards share a suit: straights become straight flushes, lower types become flushes
+        if (type == 5) {
+            int flushType = (ranks[0] == 10 && ranks[4] == 14) ? 10 : 9;
+            flushKeys[id] = Evaluator::packKey(flushType, ranks[4], 0, 0, 0);
+        } else if (type == 8 || type == 7) {
+            flushKeys[id] = key & KEY_BITS;
+        } else {
+            flushKeys[id] = Evaluator::packKey(6, ranks[4], 0, 0, 0);
+        }
+    }
+}
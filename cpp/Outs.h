@@ -0,0 +1,73 @@
+#ifndef OUTS
+#define OUTS
+
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "Deck.h"
+#include "Hand.h"
+
+/* Represents the draw ("outs") analysis of a partial hand.
+   Given a hand of fewer than five cards and the cards left in the deck, every way of completing
+   the hand from the deck is evaluated, giving its strength key (see Evaluator.h) and the chance
+   of finishing with each hand type. Completing cards are taken in deck order, the order they
+   would be drawn in, after the hand's own cards.
+   Hands are not re-assessed per completion: the ranks of the hand walk a precomputed table of
+   rank-count transitions, and each complete five card state already knows its type and tie-breakers.
+   A partial hand holding a card twice (possible with a file deck) is rejected: it has no completions.
+   One Outs can analyze many hands in turn, keeping its output buffers between them. */
+class Outs {
+
+private:
+
+    std::vector<int> partial;
+    std::vector<int> remaining;
+    std::vector<unsigned short> deckCards;
+    std::unique_ptr<int[]> keys;
+    std::unique_ptr<unsigned char[]> added;
+    long keyCapacity;
+    long addedCapacity;
+    std::vector<long> typeCounts;
+    std::vector<int> stateCounts;
+    long filled;
+    int need;
+    int suitsByCard[60];
+    int nextSlot[15];
+    unsigned char picked[5];
+
+    // Rank-count tables shared by every analysis, built on first use
+    static std::vector<int> transitions;
+    static std::vector<int> stateKeys;
+    static std::vector<int> flushKeys;
+    static std::once_flag tablesBuilt;
+
+    // Outer-Defined Class Methods //
+    void load(Hand& hand, Deck& deck);
+    void grow(long combinations, int missing);
+    void extend(int depth, size_t start, int state, int flushSuit);
+    void extendFour(int state, int flushSuit);
+    void finish(size_t start, int state, int flushSuit);
+    static void buildTables();
+
+public:
+
+    /* Constructs a new analysis with no hand loaded; see analyze(Hand&, Deck&). */
+    Outs() : partial(), remaining(), deckCards(), keys(), added(), keyCapacity(0), addedCapacity(0),
+             typeCounts(11, 0), stateCounts(), filled(0), need(0), picked() {}
+
+
+    // Outer-Defined Class Methods //
+    Outs(Hand& hand, Deck& deck);
+    static void prepare();
+    void reserve(int missing, int deckSize);
+    void analyze();
+    void analyze(Hand& hand, Deck& deck);
+    long getCompletions();
+    int getKey(long completion);
+    int getAddedCard(long completion, int card);
+    double getProbability(int type);
+
+};
+
+
+#endif
@@ -0,0 +1,51 @@
+#ifndef RANDOM
+#define RANDOM
+
+/* Represents a small deterministic random number generator (SplitMix64).
+   Unlike rand(), the same seed produces the same stream on every platform,
+   so a seeded shuffle can be regenerated exactly. */
+class Random {
+
+private:
+
+    unsigned long long state;
+
+public:
+
+    /* Constructs a new generator from the specified seed.
+       param: seed - unsigned long long representing the starting state. */
+    Random(unsigned long long seed) : state(seed) {}
+
+
+    /* Advances the generator and returns the next 64 random bits.
+       return: unsigned long long representing the next random value. */
+    unsigned long long next() {
+        unsigned long long z = (state += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+
+    /* Returns a random value in the range [0, n) using Lemire's multiply-shift
+       reduction instead of a modulo.
+       param: n - int representing the exclusive upper bound.
+       return: int representing the bounded random value. */
+    int bounded(int n) {
+        return static_cast<int>(((next() >> 32) * static_cast<unsigned long long>(n)) >> 32);
+    }
+
+
+    /* Derives the seed of an individual game from a base seed and the game's index.
+       param: base - unsigned long long representing the base seed of a run.
+       param: index - unsigned long long representing the game number within the run.
+       return: unsigned long long representing the game's seed. */
+    static unsigned long long gameSeed(unsigned long long base, unsigned long long index) {
+        Random r(base + index * 0xD1B54A32D192ED03ULL);
+        return r.next();
+    }
+
+};
+
+
+#endif
@@ -0,0 +1,83 @@
+#include "FiveHand.h"
+#include "Random.h"
+#include "ReplayLog.h"
+#include <cstdlib>
+#include <iostream>
+
+/* Main method for the replay tool.
+   Usage:
+     replay record <log> <games> [seed]   play seeded games and append them to a log
+     replay show <log> <record>           reprint a logged game exactly as play printed it
+     replay verify <log> [first] [count]  replay logged games and check their winning orders
+   param: agrc - int representing the number of command line arguments.
+   param: argv - string array representing command line arguments. */
+int main(int argc, char *argv[]) {
+    std::string mode = (argc > 2) ? argv[1] : "";
+    std::string path = (argc > 2) ? argv[2] : "";
+    ReplayLog log;
+
+    if (mode == "record" && argc > 3) {
+        unsigned long long games = std::strtoull(argv[3], NULL, 10);
+        unsigned long long base = (argc > 4) ? std::strtoull(argv[4], NULL, 10) : 1;
+        if (!log.openForAppend(path)) return 1;
+
+        for (unsigned long long i = 0; i < games; i++) {
+            unsigned long long seed = Random::gameSeed(base, i);
+            FiveHand game(seed);
+            game.drawCards(0);
+
+            std::vector<int> order = game.winningOrder();
+            log.append(seed, i, order);
+        }
+
+        log.close();
+        std::cout << "*** " << games << " games logged to " << path << " ***" << std::endl;
+        return 0;
+    }
+
+    if (mode == "show" && argc > 3) {
+        unsigned long long seed, number;
+        std::vector<int> order;
+
+        if (!log.openForRead(path) || !log.read(std::strtoull(argv[3], NULL, 10), seed, number, order)) {
+            std::cerr << "No such game: " << argv[3] << std::endl;
+            return 1;
+        }
+
+        std::cout << "*** Game " << number << ", seed " << seed << " ***" << std::endl;
+        FiveHand game(seed);
+        game.play("");
+        return 0;
+    }
+
+    if (mode == "verify") {
+        if (!log.openForRead(path)) return 1;
+
+        unsigned long long first = (argc > 3) ? std::strtoull(argv[3], NULL, 10) : 0;
+        unsigned long long count = (argc > 4) ? std::strtoull(argv[4], NULL, 10) : log.getCount();
+        unsigned long long checked = 0, failed = 0;
+
+        for (unsigned long long r = first; r < first + count && r < log.getCount(); r++) {
+            unsigned long long seed, number;
+            std::vector<int> order;
+            log.read(r, seed, number, order);
+
+            FiveHand game(seed);
+            game.drawCards(0);
+            checked++;
+
+            if (game.winningOrder() != order) {
+                failed++;
+                std::cout << "*** MISMATCH in record " << r << " (game " << number << ", seed " << seed << ") ***" << std::endl;
+            }
+        }
+
+        std::cout << "*** " << checked << " games replayed, " << failed << " mismatches ***" << std::endl;
+        return failed == 0 ? 0 : 1;
+    }
+
+    std::cerr << "usage: replay record <log> <games> [seed]\n"
+              << "       replay show <log> <record>\n"
+              << "       replay verify <log> [first] [count]" << std::endl;
+    return 2;
+}
@@ -0,0 +1,155 @@
+#include "ReplayLog.h"
+#include <filesystem>
+#include <iostream>
+
+/* Writes a value as little-endian bytes.
+   param: out - char array to write into.
+   param: value - unsigned long long representing the value.
+   param: bytes - int representing the number of bytes to write. */
+static void putBytes(char* out, unsigned long long value, int bytes) {
+    for (int i = 0; i < bytes; i++) out[i] = (char) (value >> (8 * i));
+}
+
+
+/* Reads a value from little-endian bytes.
+   param: in - char array to read from.
+   param: bytes - int representing the number of bytes to read.
+   return: unsigned long long representing the value. */
+static unsigned long long getBytes(const char* in, int bytes) {
+    unsigned long long value = 0;
+    for (int i = 0; i < bytes; i++) value |= (unsigned long long) (unsigned char) in[i] << (8 * i);
+    return value;
+}
+
+
+/* Opens a log for appending, creating it if it does not exist.
+   An existing log must have a valid header. A partial record left at its end (e.g. by a torn
+   write) is cut off, so the records appended after it stay aligned.
+   param: path - string representing the log file.
+   return: bool representing if the log could be opened. */
+bool ReplayLog::openForAppend(std::string &path) {
+    std::ifstream existing(path, std::ios::binary | std::ios::ate);
+    long long size = existing.is_open() ? (long long) existing.tellg() : 0;
+
+    if (size > 0) {
+        char header[HEADER_SIZE];
+        existing.seekg(0);
+
+        if (size < (long long) HEADER_SIZE || !existing.read(header, HEADER_SIZE) ||
+            std::string(header, 4) != "FHRL" || getBytes(header + 4, 4) != VERSION) {
+            std::cerr << "Not a replay log: " << path << std::endl;
+            return false;
+        }
+    }
+
+    existing.close();
+
+    long long whole = (size > 0) ? size - (size - HEADER_SIZE) % RECORD_SIZE : 0;
+    if (whole < size) {
+        std::error_code error;
+        std::filesystem::resize_file(path, whole, error);
+
+        if (error) {
+            std::cerr << "Failed to truncate partial record: " << path << std::endl;
+            return false;
+        }
+
+        std::cerr << "Dropped " << (size - whole) << " bytes of a partial record: " << path << std::endl;
+        size = whole;
+    }
+
+    file.open(path, std::ios::out | std::ios::binary | std::ios::app);
+    if (!file.is_open()) {
+        std::cerr << "Failed to open file: " << path << std::endl;
+        return false;
+    }
+
+    if (size == 0) {
+        char header[HEADER_SIZE];
+        header[0] = 'F'; header[1] = 'H'; header[2] = 'R'; header[3] = 'L';
+        putBytes(header + 4, VERSION, 4);
+        file.write(header, HEADER_SIZE);
+        size = HEADER_SIZE;
+    }
+
+    count = (size - HEADER_SIZE) / RECORD_SIZE;
+    return true;
+}
+
+
+/* Opens an existing log for reading.
+   param: path - string representing the log file.
+   return: bool representing if the log could be opened and has a valid header. */
+bool ReplayLog::openForRead(std::string &path) {
+    file.open(path, std::ios::in | std::ios::binary | std::ios::ate);
+    if (!file.is_open()) {
+        std::cerr << "Failed to open file: " << path << std::endl;
+        return false;
+    }
+
+    long long size = file.tellg();
+    char header[HEADER_SIZE];
+    file.seekg(0);
+
+    if (size < (long long) HEADER_SIZE || !file.read(header, HEADER_SIZE) ||
+        std::string(header, 4) != "FHRL" || getBytes(header + 4, 4) != VERSION) {
+        std::cerr << "Not a replay log: " << path << std::endl;
+        return false;
+    }
+
+    count = (size - HEADER_SIZE) / RECORD_SIZE;
+    return true;
+}
+
+
+/* Appends a game to the log. Safe to call from several threads.
+   param: seed - unsigned long long representing the seed the game's deck was shuffled from.
+   param: game - unsigned long long representing the game number (only the low 40 bits are kept).
+   param: order - vector representing the hand indices in winning order.
+   return: unsigned long long representing the game's record number. */
+unsigned long long ReplayLog::append(unsigned long long seed, unsigned long long game, std::vector<int> &order) {
+    unsigned long long packed = 0;
+    for (size_t i = 0; i < order.size(); i++) packed |= (unsigned long long) order[i] << (3 * i);
+
+    std::lock_guard<std::mutex> guard(lock);
+
+    char record[RECORD_SIZE];
+    putBytes(record, seed, 8);
+    putBytes(record + 8, game, 5);
+    putBytes(record + 13, packed, 3);
+    file.write(record, RECORD_SIZE);
+
+    return count++;
+}
+
+
+/* Reads a game from the log by its record number, without reading the records before it.
+   param: record - unsigned long long representing the record number.
+   param: seed - unsigned long long set to the game's seed.
+   param: game - unsigned long long set to the game number stored in the record.
+   param: order - vector set to the hand indices in winning order.
+   return: bool representing if the record exists. */
+bool ReplayLog::read(unsigned long long record, unsigned long long &seed, unsigned long long &game,
+                     std::vector<int> &order) {
+    if (record >= count) return false;
+
+    char data[RECORD_SIZE];
+    file.seekg(HEADER_SIZE + record * RECORD_SIZE);
+    if (!file.read(data, RECORD_SIZE)) return false;
+
+    seed = getBytes(data, 8);
+    game = getBytes(data + 8, 5);
+
+    unsigned long long packed = getBytes(data + 13, 3);
+    order.clear();
+    for (int i = 0; i < 6; i++) order.push_back((packed >> (3 * i)) & 7);
+
+    return true;
+}
+
+
+// Flushes and closes the log.
+void ReplayLog::close() {
+    std::lock_guard<std::mutex> guard(lock);
+    if (file.is_open()) file.close();
+}
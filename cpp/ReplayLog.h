@@ -0,0 +1,51 @@
+#ifndef REPLAYLOG
+#define REPLAYLOG
+
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/* Represents an append-only log of seeded games.
+   Instead of the printed game, each game is stored as a fixed size record of its seed, its
+   game number and its winning order, so any game can be found by position and replayed by
+   rebuilding its deck from the seed (see Deck::buildSeededDeck).
+   File layout, little-endian: "FHRL", uint32 version, then one 16 byte record per game:
+     uint64 seed | 40 bit game number | 24 bit winning order (six 3 bit hand indices, winner first)
+   The game number is chosen by the writer: the game's position in its run for "replay record",
+   the DEAL request's id for the server. */
+class ReplayLog {
+
+private:
+
+    std::fstream file;
+    std::mutex lock;
+    unsigned long long count;
+
+public:
+
+    static const unsigned int VERSION = 1;
+    static const size_t HEADER_SIZE = 8;
+    static const size_t RECORD_SIZE = 16;
+
+
+    /* Constructs a new log that is not open yet. */
+    ReplayLog() : file(), lock(), count(0) {}
+
+
+    /* Gets the number of games in the log.
+       return: unsigned long long representing the number of records. */
+    unsigned long long getCount() {return count;}
+
+
+    // Outer-Defined Class Methods //
+    bool openForAppend(std::string& path);
+    bool openForRead(std::string& path);
+    unsigned long long append(unsigned long long seed, unsigned long long game, std::vector<int>& order);
+    bool read(unsigned long long record, unsigned long long& seed, unsigned long long& game, std::vector<int>& order);
+    void close();
+
+};
+
+
+#endif
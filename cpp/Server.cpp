@@ -0,0 +1,463 @@
+#include "Server.h"
+#include "Evaluator.h"
+#include "FiveHand.h"
+#include <algorithm>
+#include <cerrno>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <fcntl.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+// Set by SIGINT/SIGTERM; the event loop notices it within one epoll timeout
+static volatile std::sig_atomic_t stopRequested = 0;
+
+static void requestStop(int) {stopRequested = 1;}
+
+
+/* Starts the server and runs its event loop until SIGINT or SIGTERM is received.
+   On shutdown, the number of requests and the p50/p99 latencies are printed.
+   return: bool representing if the server could be started. */
+bool Server::run() {
+    sockaddr_un addr;
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+
+    if (path.size() >= sizeof(addr.sun_path)) {
+        std::cerr << "Socket path too long: " << path << std::endl;
+        return false;
+    }
+
+    std::strcpy(addr.sun_path, path.c_str());
+    unlink(path.c_str());
+
+    listenFd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0);
+    if (listenFd < 0 || bind(listenFd, (sockaddr*) &addr, sizeof(addr)) < 0 || listen(listenFd, 128) < 0) {
+        std::perror("Failed to listen");
+        return false;
+    }
+
+    epollFd = epoll_create1(0);
+    epoll_event ev;
+    ev.events = EPOLLIN;
+    ev.data.fd = listenFd;
+    epoll_ctl(epollFd, EPOLL_CTL_ADD, listenFd, &ev);
+
+    std::signal(SIGINT, requestStop);
+    std::signal(SIGTERM, requestStop);
+    std::signal(SIGPIPE, SIG_IGN);
+
+    for (int t = 0; t < threads; t++) {
+        workers.push_back(std::thread(&Server::work, this));
+    }
+
+    std::cout << "*** Listening on " << path << " with " << threads << " workers ***" << std::endl;
+
+    epoll_event events[64];
+    while (!stopRequested) {
+        int n = epoll_wait(epollFd, events, 64, 200);
+
+        for (int i = 0; i < n; i++) {
+            if (events[i].data.fd == listenFd) {
+                acceptConnections();
+                continue;
+            }
+
+            std::map<int, std::shared_ptr<Connection>>::iterator it = connections.find(events[i].data.fd);
+            if (it == connections.end()) continue;
+            std::shared_ptr<Connection> conn = it->second;
+
+            if (events[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR)) readConnection(conn);
+            if ((events[i].events & EPOLLOUT) && !conn->closed) writeConnection(conn);
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> guard(jobLock);
+        stopping = true;
+    }
+    jobReady.notify_all();
+
+    for (std::thread &worker: workers) worker.join();
+    while (!connections.empty()) closeConnection(connections.begin()->second);
+
+    close(epollFd);
+    close(listenFd);
+    unlink(path.c_str());
+    replayLog.close();
+
+    long long count;
+    int p50, p99;
+    getPercentiles(count, p50, p99);
+    std::cout << "\n*** " << count << " requests, p50 " << p50 << " us, p99 " << p99 << " us ***" << std::endl;
+
+    return true;
+}
+
+
+/* Appends every game dealt by a DEAL request to a replay log.
+   param: logFile - string representing the log file, created if it does not exist.
+   return: bool representing if the log could be opened. */
+bool Server::logGames(std::string &logFile) {
+    logging = replayLog.openForAppend(logFile);
+    return logging;
+}
+
+
+// Accepts every pending connection and adds it to the event loop.
+void Server::acceptConnections() {
+    while (true) {
+        int fd = accept4(listenFd, NULL, NULL, SOCK_NONBLOCK);
+        if (fd < 0) return;
+
+        epoll_event ev;
+        ev.events = EPOLLIN;
+        ev.data.fd = fd;
+        epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &ev);
+
+        connections[fd] = std::make_shared<Connection>(fd);
+    }
+}
+
+
+/* Reads everything available on a connection and hands each complete frame to the workers.
+   On end of file the frames already read are still answered: reading stops, and the connection
+   is closed once its pending requests are answered and written (see writeConnection).
+   The connection is closed at once on a read error or on a malformed frame length.
+   param: conn - Connection representing the connection to read. */
+void Server::readConnection(std::shared_ptr<Connection> conn) {
+    char buffer[65536];
+    bool eof = false;
+
+    while (true) {
+        ssize_t n = read(conn->fd, buffer, sizeof(buffer));
+
+        if (n > 0) {
+            conn->input.append(buffer, n);
+            continue;
+        }
+
+        if (n < 0 && errno == EINTR) continue;
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) break;
+
+        // A second end of file comes with EPOLLHUP: the client is gone and cannot read responses
+        if (n == 0 && !conn->eof) {
+            eof = true;
+            break;
+        }
+
+        closeConnection(conn);
+        return;
+    }
+
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    std::vector<Job> ready;
+    size_t pos = 0;
+
+    while (conn->input.size() - pos >= 4) {
+        unsigned int length;
+        std::memcpy(&length, conn->input.data() + pos, 4);
+
+        if (length + 4 < HEADER_SIZE || length > MAX_FRAME) {
+            closeConnection(conn);
+            return;
+        }
+
+        if (conn->input.size() - pos < length + 4) break;
+
+        Job job;
+        job.conn = conn;
+        job.frame = conn->input.substr(pos, length + 4);
+        job.received = now;
+        ready.push_back(job);
+        pos += length + 4;
+    }
+
+    conn->input.erase(0, pos);
+
+    // Counted before the workers can see the jobs, so pending never drops to 0 early
+    {
+        std::lock_guard<std::mutex> guard(conn->lock);
+        conn->pending += ready.size();
+
+        // Stop reading; the first EPOLLOUT closes the connection if nothing is pending
+        if (eof) {
+            conn->eof = true;
+            watch(*conn, true);
+        }
+    }
+
+    if (!ready.empty()) {
+        std::lock_guard<std::mutex> guard(jobLock);
+        jobs.insert(jobs.end(), ready.begin(), ready.end());
+    }
+
+    if (ready.size() == 1) jobReady.notify_one();
+    else if (ready.size() > 1) jobReady.notify_all();
+}
+
+
+/* Writes queued responses once the socket can take more data.
+   A connection whose client has shut down its side is closed once nothing is left to answer.
+   param: conn - Connection representing the connection to write. */
+void Server::writeConnection(std::shared_ptr<Connection> conn) {
+    {
+        std::lock_guard<std::mutex> guard(conn->lock);
+        if (conn->closed) return;
+
+        bool usable = flush(*conn);
+        if (usable && !conn->output.empty()) return;
+
+        if (usable && !(conn->eof && conn->pending == 0)) {
+            watch(*conn, false);
+            return;
+        }
+    }
+
+    closeConnection(conn);
+}
+
+
+/* Closes a connection and removes it from the event loop.
+   Workers still holding the connection see it as closed and drop their responses.
+   param: conn - Connection representing the connection to close. */
+void Server::closeConnection(std::shared_ptr<Connection> conn) {
+    {
+        std::lock_guard<std::mutex> guard(conn->lock);
+        conn->closed = true;
+        epoll_ctl(epollFd, EPOLL_CTL_DEL, conn->fd, NULL);
+        close(conn->fd);
+    }
+
+    connections.erase(conn->fd);
+}
+
+
+/* Sets the events the event loop waits for on a connection.
+   Reading stops after end of file. The caller must hold the connection's lock.
+   param: conn - Connection representing the connection.
+   param: writing - bool representing if the loop should wait for the socket to be writable. */
+void Server::watch(Connection &conn, bool writing) {
+    epoll_event ev;
+    ev.events = 0;
+    if (!conn.eof) ev.events |= EPOLLIN;
+    if (writing) ev.events |= EPOLLOUT;
+    ev.data.fd = conn.fd;
+    epoll_ctl(epollFd, EPOLL_CTL_MOD, conn.fd, &ev);
+}
+
+
+/* Writes as much of a connection's queued output as the socket accepts.
+   The caller must hold the connection's lock.
+   param: conn - Connection representing the connection to write.
+   return: bool representing if the socket is still usable. */
+bool Server::flush(Connection &conn) {
+    while (!conn.output.empty()) {
+        ssize_t n = write(conn.fd, conn.output.data(), conn.output.size());
+
+        if (n > 0) conn.output.erase(0, n);
+        else if (n < 0 && errno == EINTR) continue;
+        else return n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK);
+    }
+
+    return true;
+}
+
+
+// Worker thread: answers queued requests until the server stops.
+void Server::work() {
+    while (true) {
+        Job job;
+
+        {
+            std::unique_lock<std::mutex> guard(jobLock);
+            jobReady.wait(guard, [this]() {return stopping || !jobs.empty();});
+            if (stopping) return;
+
+            job = jobs.front();
+            jobs.pop_front();
+        }
+
+        std::string response = answer(job.frame);
+
+        {
+            std::lock_guard<std::mutex> guard(job.conn->lock);
+            job.conn->pending--;
+
+            if (!job.conn->closed) {
+                bool idle = job.conn->output.empty();
+                job.conn->output += response;
+
+                // Anything the socket did not take now is written by the event loop, which also
+                // closes a shut down connection once its last response is out
+                bool unsent = !idle || !flush(*job.conn) || !job.conn->output.empty();
+                if ((idle && unsent) || (job.conn->eof && job.conn->pending == 0)) watch(*job.conn, true);
+            }
+        }
+
+        std::chrono::steady_clock::duration elapsed = std::chrono::steady_clock::now() - job.received;
+        recordLatency(std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count());
+    }
+}
+
+
+/* Reads the five card codes of a hand in a request.
+   param: cards - unsigned char array representing the hand's five codes.
+   param: codes - int array set to the codes.
+   return: bool representing if every code is a card (0 - 51) and no card is repeated. */
+static bool readHand(const unsigned char* cards, int* codes) {
+    unsigned long long seen = 0;
+
+    for (int i = 0; i < 5; i++) {
+        codes[i] = cards[i];
+        if (codes[i] > 51 || (seen >> codes[i] & 1)) return false;
+        seen |= 1ULL << codes[i];
+    }
+
+    return true;
+}
+
+
+/* Answers one request frame.
+   param: request - string representing the complete request frame, header included.
+   return: string representing the complete response frame. */
+std::string Server::answer(std::string &request) {
+    const unsigned char* data = (const unsigned char*) request.data();
+    const unsigned char* body = data + HEADER_SIZE;
+    size_t size = request.size() - HEADER_SIZE;
+    int op = data[4];
+    unsigned int id;
+    std::memcpy(&id, data + 8, 4);
+
+    std::string out;
+    int status = OK;
+
+    if (op == EVALUATE && size >= 2) {
+        unsigned short n;
+        std::memcpy(&n, body, 2);
+        if (size != 2 + n * 5u) status = BAD_REQUEST;
+
+        for (int h = 0; h < n && status == OK; h++) {
+            int codes[5];
+            if (!readHand(body + 2 + h * 5, codes)) {
+                status = BAD_REQUEST;
+                break;
+            }
+
+            int key = Evaluator::codeStrengthKey(codes);
+            out.append((const char*) &key, 4);
+        }
+    } else if (op == RANK && size >= 1) {
+        int n = body[0];
+        if (size != 1 + n * 5u) status = BAD_REQUEST;
+
+        std::vector<int> keys;
+        std::vector<unsigned char> order;
+        for (int h = 0; h < n && status == OK; h++) {
+            int codes[5];
+            if (!readHand(body + 1 + h * 5, codes)) {
+                status = BAD_REQUEST;
+                break;
+            }
+
+            keys.push_back(Evaluator::codeStrengthKey(codes));
+            order.push_back(h);
+        }
+
+        std::stable_sort(order.begin(), order.end(), [&keys](int a, int b) {
+            return keys[a] > keys[b];
+        });
+        out.append(order.begin(), order.end());
+    } else if (op == DEAL && size == 8) {
+        unsigned long long seed;
+        std::memcpy(&seed, body, 8);
+
+        FiveHand game(seed);
+        game.drawCards(0);
+
+        for (Hand &hand: game.getHands()) {
+            for (Card &card: hand.getCards()) out += (char) card.getCode();
+        }
+
+        std::vector<int> order = game.winningOrder();
+        for (int i: order) out += (char) i;
+        if (logging) replayLog.append(seed, id, order);
+
+        for (Hand &hand: game.getHands()) {
+            int key = hand.getStrengthKey();
+            out.append((const char*) &key, 4);
+        }
+    } else if (op == STATS && size == 0) {
+        long long count;
+        int p50, p99;
+        getPercentiles(count, p50, p99);
+
+        out.append((const char*) &count, 8);
+        out.append((const char*) &p50, 4);
+        out.append((const char*) &p99, 4);
+    } else {
+        status = BAD_REQUEST;
+    }
+
+    if (status != OK) out.clear();
+
+    return frame(op, status, id, out);
+}
+
+
+/* Adds one request's latency to the histogram.
+   param: micros - long long representing the time from receiving the request to answering it. */
+void Server::recordLatency(long long micros) {
+    std::lock_guard<std::mutex> guard(latencyLock);
+    latency[std::min(micros, (long long) MAX_LATENCY)]++;
+}
+
+
+/* Reads the request count and latency percentiles from the histogram.
+   param: count - long long set to the number of requests answered.
+   param: p50 - int set to the median latency in microseconds.
+   param: p99 - int set to the 99th percentile latency in microseconds. */
+void Server::getPercentiles(long long &count, int &p50, int &p99) {
+    std::lock_guard<std::mutex> guard(latencyLock);
+
+    count = 0;
+    for (long long n: latency) count += n;
+
+    p50 = -1;
+    p99 = -1;
+    long long seen = 0;
+
+    for (int us = 0; us <= MAX_LATENCY && p99 < 0; us++) {
+        seen += latency[us];
+        if (p50 < 0 && seen * 2 >= count && seen > 0) p50 = us;
+        if (p99 < 0 && seen * 100 >= count * 99 && seen > 0) p99 = us;
+    }
+
+    if (p50 < 0) p50 = 0;
+    if (p99 < 0) p99 = 0;
+}
+
+
+/* Main method for the Five Hand server.
+   Usage: server <socket path> [threads] [replay log]
+   param: agrc - int representing the number of command line arguments.
+   param: argv - string array representing command line arguments. */
+int main(int argc, char *argv[]) {
+    if (argc < 2) {
+        std::cerr << "usage: server <socket path> [threads] [replay log]" << std::endl;
+        return 2;
+    }
+
+    int threads = (argc > 2) ? std::atoi(argv[2]) : std::thread::hardware_concurrency();
+    Server server(argv[1], threads);
+
+    std::string logFile = (argc > 3) ? argv[3] : "";
+    if (!logFile.empty() && !server.logGames(logFile)) return 1;
+
+    return server.run() ? 0 : 1;
+}
@@ -0,0 +1,144 @@
+#ifndef SERVER
+#define SERVER
+
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "ReplayLog.h"
+
+/* Represents one client connection of the server.
+   Requests are read by the event loop; responses are queued by the worker threads.
+   Once the client shuts down its side (end of file), reading stops, but the connection is kept
+   until every pending request is answered and its output is written. */
+class Connection {
+
+public:
+
+    int fd;
+    bool closed;
+    bool eof;
+    int pending;
+    std::string input;
+    std::string output;
+    std::mutex lock;
+
+    /* Constructs a new connection for an accepted socket.
+       param: f - int representing the socket's file descriptor. */
+    Connection(int f) : fd(f), closed(false), eof(false), pending(0), input(), output(), lock() {}
+
+};
+
+
+/* Represents one complete request frame waiting for a worker thread. */
+class Job {
+
+public:
+
+    std::shared_ptr<Connection> conn;
+    std::string frame;
+    std::chrono::steady_clock::time_point received;
+
+};
+
+
+/* Represents a long-lived Five Hand server listening on a Unix domain socket.
+   An epoll event loop reads framed binary requests, and a pool of worker threads answers them.
+   Every frame (request or response) starts with a 12 byte header in host byte order:
+     uint32 length of the rest of the frame | uint8 op | uint8 status | uint16 unused | uint32 id
+   Request and response bodies, cards being codes from 0 to 51 (see Card::getCode):
+     EVALUATE  uint16 n, n * 5 cards   ->  n * int32 strength keys
+     RANK      uint8 n, n * 5 cards    ->  n * uint8 hand indices in winning order
+     DEAL      uint64 seed             ->  30 cards (six hands as dealt), 6 * uint8 winning order,
+                                           6 * int32 strength keys
+     STATS     (empty)                 ->  uint64 requests, uint32 p50 and p99 latency in microseconds
+   A malformed request, or a hand holding a code above 51 or the same card twice, is answered
+   with status BAD_REQUEST and an empty body.
+   Dealt games can be appended to a replay log (see ReplayLog.h). */
+class Server {
+
+private:
+
+    std::string path;
+    int threads;
+    int listenFd;
+    int epollFd;
+    bool stopping;
+    std::map<int, std::shared_ptr<Connection>> connections;
+    std::vector<std::thread> workers;
+    std::deque<Job> jobs;
+    std::mutex jobLock;
+    std::condition_variable jobReady;
+    std::vector<long long> latency;
+    std::mutex latencyLock;
+    ReplayLog replayLog;
+    bool logging;
+
+    // Outer-Defined Class Methods //
+    void acceptConnections();
+    void readConnection(std::shared_ptr<Connection> conn);
+    void writeConnection(std::shared_ptr<Connection> conn);
+    void closeConnection(std::shared_ptr<Connection> conn);
+    bool flush(Connection& conn);
+    void watch(Connection& conn, bool writing);
+    void work();
+    std::string answer(std::string& frame);
+    void recordLatency(long long micros);
+    void getPercentiles(long long& count, int& p50, int& p99);
+
+public:
+
+    // Request operations and response status codes
+    static const int EVALUATE = 1;
+    static const int RANK = 2;
+    static const int DEAL = 3;
+    static const int STATS = 4;
+    static const int OK = 0;
+    static const int BAD_REQUEST = 1;
+    static const size_t HEADER_SIZE = 12;
+    static const size_t MAX_FRAME = 1 << 20;
+
+    // Latencies are kept in a histogram of one microsecond buckets; slower requests share the last one
+    static const int MAX_LATENCY = 100000;
+
+
+    /* Constructs a new server for the given socket path.
+       param: p - string representing the path of the Unix domain socket.
+       param: t - int representing the number of worker threads. */
+    Server(std::string p, int t) : path(p), threads(t < 1 ? 1 : t), listenFd(-1), epollFd(-1),
+                                   stopping(false), latency(MAX_LATENCY + 1, 0), logging(false) {}
+
+
+    /* Builds a frame from its header fields and body. Shared by the server and its clients.
+       param: op - int representing the operation.
+       param: status - int representing the status (always OK for requests).
+       param: id - unsigned int representing the id the client chose for the request.
+       param: body - string representing the body of the frame.
+       return: string representing the complete frame. */
+    static std::string frame(int op, int status, unsigned int id, std::string& body) {
+        unsigned int length = HEADER_SIZE - 4 + body.size();
+        char header[HEADER_SIZE] = {0};
+
+        std::memcpy(header, &length, 4);
+        header[4] = (char) op;
+        header[5] = (char) status;
+        std::memcpy(header + 8, &id, 4);
+
+        return std::string(header, HEADER_SIZE) + body;
+    }
+
+
+    // Outer-Defined Class Methods //
+    bool run();
+    bool logGames(std::string& logFile);
+
+};
+
+
+#endif
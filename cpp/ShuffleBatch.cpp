@@ -0,0 +1,60 @@
+#include "ShuffleBatch.h"
+#include "Dispatch.h"
+#include "Evaluator.h"
+
+/* Draws one bounded random number per lane.
+   Random::bounded has no branches, but SplitMix64 needs 64 bit vector multiplies, so the loop
+   only vectorizes for AVX2 and up: the AVX2/AVX-512 clones (FIVEHAND_DISPATCH, on by default) or
+   FIVEHAND_MARCH=x86-64-v3. For the baseline x86-64 target it runs one lane at a time.
+   param: rng - Random array representing the generator of each lane.
+   param: picks - int array set to the numbers drawn.
+   param: lanes - int representing the number of lanes.
+   param: bound - int representing the exclusive upper bound. */
+HOT_CLONES static void drawPicks(Random* rng, int* picks, int lanes, int bound) {
+    for (int l = 0; l < lanes; l++) picks[l] = rng[l].bounded(bound);
+}
+
+
+/* Shuffles every deck of the batch from its own seed.
+   param: seeds - unsigned long long array representing one seed per lane. */
+void ShuffleBatch::shuffle(const unsigned long long* seeds) {
+    unsigned char* deck = cards.data();
+    Random* rng = rngs.data();
+    int* k = picks.data();
+
+    // Unshuffled order, as Deck::buildSeededDeck builds it before shuffling
+    for (int p = 0; p < 52; p++) {
+        for (int l = 0; l < lanes; l++) deck[p * lanes + l] = p;
+    }
+
+    for (int l = 0; l < lanes; l++) rng[l] = Random(seeds[l]);
+
+    for (int n = 51; n > 0; n--) {
+        drawPicks(rng, k, lanes, n + 1);
+
+        unsigned char* last = deck + n * lanes;
+        for (int l = 0; l < lanes; l++) {
+            unsigned char* pick = deck + k[l] * lanes + l;
+            unsigned char value = *pick;
+            *pick = last[l];
+            last[l] = value;
+        }
+    }
+}
+
+
+/* Deals six hands from every deck, as FiveHand::drawCards does for a randomized game
+   (card i goes to hand i % 6), and evaluates them.
+   param: keys - int array set to the strength keys, keys[lane * 6 + hand]. */
+void ShuffleBatch::dealKeys(int* keys) {
+    const unsigned char* deck = cards.data();
+
+    for (int l = 0; l < lanes; l++) {
+        for (int h = 0; h < 6; h++) {
+            int codes[5];
+            for (int c = 0; c < 5; c++) codes[c] = deck[(h + c * 6) * lanes + l];
+
+            keys[l * 6 + h] = Evaluator::codeStrengthKey(codes);
+        }
+    }
+}
@@ -0,0 +1,50 @@
+#ifndef SHUFFLEBATCH
+#define SHUFFLEBATCH
+
+#include <vector>
+#include "Random.h"
+
+/* Represents a batch of independently shuffled 52 card decks.
+   Each deck (lane) is shuffled from its own seed with the same Fisher-Yates walk and random
+   stream as Deck::buildSeededDeck, so lane i holds exactly the deck a FiveHand built from seed i
+   would hold. The random numbers for every lane are drawn in one tight loop the compiler
+   vectorizes when AVX2 is available (see drawPicks in ShuffleBatch.cpp), and the decks are
+   stored position-major (structure of arrays):
+     card code at position p of lane l = cards[p * lanes + l]
+   so dealing and evaluating many games reads contiguous memory. */
+class ShuffleBatch {
+
+private:
+
+    int lanes;
+    std::vector<unsigned char> cards;
+    std::vector<Random> rngs;
+    std::vector<int> picks;
+
+public:
+
+    /* Constructs a new batch holding the given number of decks (at least one).
+       param: l - int representing the number of decks shuffled per call. */
+    ShuffleBatch(int l) : lanes(l < 1 ? 1 : l), cards(52 * lanes), rngs(lanes, Random(0)), picks(lanes) {}
+
+
+    /* Gets the number of decks in the batch.
+       return: int representing the number of lanes. */
+    int getLanes() {return lanes;}
+
+
+    /* Gets the code of a card in one of the decks (see Card::getCode).
+       param: lane - int representing the deck.
+       param: position - int representing the card's position, 0 being the top of the deck.
+       return: int representing the card code. */
+    int getCard(int lane, int position) {return cards[position * lanes + lane];}
+
+
+    // Outer-Defined Class Methods //
+    void shuffle(const unsigned long long* seeds);
+    void dealKeys(int* keys);
+
+};
+
+
+#endif
@@ -0,0 +1,41 @@
+#!/bin/sh
+# Builds an oracle corpus by running a reference port on every deck of a corpus.
+# The six hands printed after "--- WINNING HAND ORDER ---" are recorded for each deck,
+# followed by a blank line, which is the format "harness check" reads.
+# A deck the port gives no winning order for (e.g. it crashes) is recorded as "NO RESULT"
+# and its number printed, so it can be listed in a known differences file.
+# usage: ./oracle.sh <decks file> <oracle file> <command...>
+#   e.g. ./oracle.sh decks.txt oracle.txt python3 ../python/FiveHand.py
+
+if [ $# -lt 3 ]; then
+    echo "usage: $0 <decks file> <oracle file> <command...>" >&2
+    exit 2
+fi
+
+decks=$1
+oracle=$2
+shift 2
+
+dir=$(mktemp -d)
+trap 'rm -rf "$dir"' EXIT
+
+# One test deck file per game
+awk -v dir="$dir" 'BEGIN { RS = "" } {
+    file = sprintf("%s/%09d.txt", dir, NR)
+    print > file
+    close(file)
+}' "$decks"
+
+: > "$oracle"
+game=0
+for file in "$dir"/*.txt; do
+    order=$("$@" "$file" 2>/dev/null | awk '/--- WINNING HAND ORDER ---/ { found = 1; next } found && NF')
+
+    if [ -z "$order" ]; then
+        echo "Game $game: no result" >&2
+        order="NO RESULT"
+    fi
+
+    printf '%s\n\n' "$order" >> "$oracle"
+    game=$((game + 1))
+done
@@ -0,0 +1,22 @@
+#!/bin/sh
+# Builds an optimized release with profile guided optimization.
+# The build is instrumented, trained on the simulation benchmark, then rebuilt with the profile.
+# Needs GCC: CMakeLists.txt refuses FIVEHAND_PGO with other compilers.
+# usage: ./pgo.sh [build dir] [extra cmake options...]
+#   The build dir defaults to build-pgo next to this script, wherever it is run from.
+#   e.g. ./pgo.sh build-pgo -DFIVEHAND_LTO=ON -DFIVEHAND_DISPATCH=ON
+
+set -e
+
+src=$(cd "$(dirname "$0")" && pwd)
+build=${1:-"$src/build-pgo"}
+[ $# -gt 0 ] && shift
+
+rm -rf "$build/pgo-profile"
+
+cmake -S "$src" -B "$build" -DCMAKE_BUILD_TYPE=Release -DFIVEHAND_PGO=GENERATE "$@"
+cmake --build "$build" -j
+cmake --build "$build" --target pgo-train
+
+cmake -S "$src" -B "$build" -DFIVEHAND_PGO=USE "$@"
+cmake --build "$build" -j
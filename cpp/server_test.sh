@@ -0,0 +1,46 @@
+#!/bin/sh
+# Round trip test of the server: starts it on a temporary socket with a replay log, sends it
+# dealt games, ranked tables and evaluated batches with the test client (one request at a time,
+# over several connections, and pipelined), stops it, then replays every game it logged.
+# usage: ./server_test.sh <build dir>
+#   e.g. ./server_test.sh build
+
+if [ $# -lt 1 ]; then
+    echo "usage: $0 <build dir>" >&2
+    exit 2
+fi
+
+bin=$1
+
+dir=$(mktemp -d)
+sock="$dir/fivehand.sock"
+log="$dir/server.replay"
+server=
+
+stop() {
+    [ -n "$server" ] && kill "$server" 2>/dev/null && wait "$server"
+    server=
+}
+trap 'stop; rm -rf "$dir"' EXIT
+
+"$bin/server" "$sock" 2 "$log" &
+server=$!
+
+# Wait up to 5 seconds for the socket to appear
+tries=0
+while [ ! -S "$sock" ]; do
+    tries=$((tries + 1))
+    if [ $tries -gt 50 ] || ! kill -0 "$server" 2>/dev/null; then
+        echo "server did not start" >&2
+        exit 1
+    fi
+    sleep 0.1
+done
+
+"$bin/client" "$sock" 200 deal 1 1 || exit 1
+"$bin/client" "$sock" 200 rank 16 2 || exit 1
+"$bin/client" "$sock" 200 evaluate 64 2 || exit 1
+"$bin/client" "$sock" 200 deal 1 4 pipeline || exit 1
+
+stop
+"$bin/replay" verify "$log" || exit 1